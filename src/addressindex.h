@@ -9,12 +9,14 @@
 #define BITCOIN_ADDRESSINDEX_H
 
 #include <amount.h>
+#include <saltedhasher.h>
 #include <serialize.h>
 #include <uint256.h>
 #include <util/underlying.h>
 
 #include <chrono>
 #include <tuple>
+#include <utility>
 
 class CScript;
 
@@ -74,6 +76,18 @@ struct CMempoolAddressDeltaKeyCompare
     }
 };
 
+/** The address part of a CMempoolAddressDeltaKey, the mempool address index is bucketed by it */
+using CMempoolAddressKey = std::pair<AddressType, uint160>;
+
+template<>
+struct SaltedHasherImpl<CMempoolAddressKey>
+{
+    static std::size_t CalcHash(const CMempoolAddressKey& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write(v.second.begin(), v.second.size()).Write(ToUnderlying(v.first)).Finalize();
+    }
+};
+
 struct CAddressIndexKey {
 public:
     AddressType m_address_type{AddressType::UNKNOWN};
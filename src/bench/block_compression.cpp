@@ -0,0 +1,106 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <bench/data.h>
+#include <chainparams.h>
+#include <node/blockcompression.h>
+#include <node/blockstorage.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <string>
+#include <vector>
+
+// A block with a coinbase version string and outputs carrying GSC contract rows
+static CBlock MakePayloadBlock()
+{
+    CBlock block{Params().GenesisBlock()};
+    CMutableTransaction coinbase{*block.vtx[0]};
+    coinbase.vout[0].sTxOutMessage = "<VER>v1.0.0.1</VER><SANC></SANC>";
+    block.vtx[0] = MakeTransactionRef(coinbase);
+    for (int tx = 0; tx < 20; ++tx) {
+        CMutableTransaction mtx;
+        mtx.vin.resize(1);
+        for (int out = 0; out < 10; ++out) {
+            std::string rows;
+            for (int i = 0; i < 30; ++i) {
+                rows += "<row><col>B" + ToString((tx * 300 + out * 30 + i) * 7919) + "</col><col>" + ToString(i % 97) + ".25</col></row>";
+            }
+            CTxOut txout;
+            txout.nValue = out;
+            txout.sTxOutMessage = rows;
+            mtx.vout.push_back(txout);
+        }
+        block.vtx.push_back(MakeTransactionRef(mtx));
+    }
+    return block;
+}
+
+static std::vector<uint8_t> Serialize(const CBlock& block)
+{
+    std::vector<uint8_t> data;
+    CVectorWriter{SER_DISK, CLIENT_VERSION, data, 0, block};
+    return data;
+}
+
+static void BlockCompressPayloads(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    const std::vector<uint8_t> data{Serialize(MakePayloadBlock())};
+    bench.batch(data.size()).unit("byte").run([&] {
+        auto compressed = CompressBlockData(data);
+        ankerl::nanobench::doNotOptimizeAway(compressed);
+    });
+}
+
+static void BlockDecompressPayloads(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    const std::vector<uint8_t> data{Serialize(MakePayloadBlock())};
+    const std::vector<uint8_t> compressed{CompressBlockData(data)};
+    std::vector<uint8_t> output;
+    bench.batch(data.size()).unit("byte").run([&] {
+        bool ok = DecompressBlockData(compressed, output, MAX_SIZE);
+        assert(ok);
+    });
+}
+
+// Mostly hashes and signatures, the worst case for the compressor
+static void BlockCompressBinary(benchmark::Bench& bench)
+{
+    const std::vector<uint8_t> data(benchmark::data::block813851.begin(), benchmark::data::block813851.end());
+    bench.batch(data.size()).unit("byte").run([&] {
+        auto compressed = CompressBlockData(data);
+        ankerl::nanobench::doNotOptimizeAway(compressed);
+    });
+}
+
+// Reading a stored block back in network format, as done when serving it to
+// peers, with and without -blockcompression
+static void ReadRawBlock(benchmark::Bench& bench, bool compression)
+{
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>();
+    const CBlock block{MakePayloadBlock()};
+    fBlockCompression = compression;
+    const FlatFilePos pos{WITH_LOCK(cs_main, return SaveBlockToDisk(block, 1, testing_setup->m_node.chainman->ActiveChain(), Params(), nullptr))};
+    fBlockCompression = DEFAULT_BLOCK_COMPRESSION;
+    assert(!pos.IsNull());
+
+    std::vector<uint8_t> raw;
+    bench.batch(::GetSerializeSize(block, PROTOCOL_VERSION)).unit("byte").run([&] {
+        bool ok = ReadRawBlockFromDisk(raw, pos, Params().MessageStart());
+        assert(ok);
+    });
+}
+
+static void ReadRawBlockUncompressed(benchmark::Bench& bench) { ReadRawBlock(bench, false); }
+static void ReadRawBlockCompressed(benchmark::Bench& bench) { ReadRawBlock(bench, true); }
+
+BENCHMARK(BlockCompressPayloads);
+BENCHMARK(BlockDecompressPayloads);
+BENCHMARK(BlockCompressBinary);
+BENCHMARK(ReadRawBlockUncompressed);
+BENCHMARK(ReadRawBlockCompressed);
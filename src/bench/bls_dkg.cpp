@@ -105,6 +105,37 @@ public:
             memberIdx = (memberIdx + 1) % members.size();
         });
     }
+
+    // Mirrors how CDKGSession verifies contributions as they arrive: batches of batchSize shares are handed to the
+    // worker and the next batch is started before waiting for the previous result
+    void Bench_VerifyContributionSharesPipelined(benchmark::Bench& bench, size_t batchSize, uint32_t epoch_iters)
+    {
+        ReceiveVvecs();
+        size_t memberIdx = 0;
+        bench.minEpochIterations(epoch_iters).run([&] {
+            ReceiveShares(memberIdx);
+
+            std::future<std::vector<bool>> inFlight;
+            for (size_t start = 0; start < receivedVvecs.size(); start += batchSize) {
+                const size_t count = std::min(batchSize, receivedVvecs.size() - start);
+                auto next = blsWorker.AsyncVerifyContributionShares(members[memberIdx].id,
+                                                                    Span{receivedVvecs}.subspan(start, count),
+                                                                    Span{receivedSkShares}.subspan(start, count),
+                                                                    true, true);
+                if (inFlight.valid()) {
+                    for (const bool valid : inFlight.get()) {
+                        assert(valid);
+                    }
+                }
+                inFlight = std::move(next);
+            }
+            for (const bool valid : inFlight.get()) {
+                assert(valid);
+            }
+
+            memberIdx = (memberIdx + 1) % members.size();
+        });
+    }
 };
 
 static void BLSDKG_GenerateContributions(benchmark::Bench& bench, uint32_t epoch_iters, int quorumSize)
@@ -166,6 +197,15 @@ static void BLSDKG_InitDKG(benchmark::Bench& bench, uint32_t epoch_iters, int qu
     } \
     BENCHMARK(BLSDKG_VerifyContributionShares_##name##_##quorumSize)
 
+#define BENCH_VerifyContributionSharesPipelined(name, quorumSize, batchSize, epoch_iters) \
+    static void BLSDKG_VerifyContributionSharesPipelined_##name##_##quorumSize(benchmark::Bench& bench) \
+    { \
+      std::unique_ptr<DKG> ptr = std::make_unique<DKG>(quorumSize); \
+      ptr->Bench_VerifyContributionSharesPipelined(bench, batchSize, epoch_iters); \
+      ptr.reset(); \
+    } \
+    BENCHMARK(BLSDKG_VerifyContributionSharesPipelined_##name##_##quorumSize)
+
 BENCH_GenerateContributions(simple, 50, 50);
 BENCH_GenerateContributions(simple, 100, 5);
 
@@ -183,3 +223,6 @@ BENCH_VerifyContributionShares(simple, 400, 5, false, 1)
 BENCH_VerifyContributionShares(aggregated, 10, 5, true, 100)
 BENCH_VerifyContributionShares(aggregated, 100, 5, true, 10)
 BENCH_VerifyContributionShares(aggregated, 400, 5, true, 1)
+
+BENCH_VerifyContributionSharesPipelined(batched, 100, 32, 10)
+BENCH_VerifyContributionSharesPipelined(batched, 400, 32, 1)
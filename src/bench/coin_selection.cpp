@@ -3,8 +3,10 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <coinjoin/common.h>
 #include <interfaces/chain.h>
 #include <node/context.h>
+#include <test/util/setup_common.h>
 #include <wallet/coinselection.h>
 #include <wallet/wallet.h>
 
@@ -110,5 +112,44 @@ static void BnBExhaustion(benchmark::Bench& bench)
     });
 }
 
+// Counting denominated inputs is done for every denomination on each CoinJoin
+// mixing round, so it should not depend on the number of other wallet outputs.
+static void CoinJoinCountInputsWithAmount(benchmark::Bench& bench)
+{
+    const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
+
+    CWallet wallet(test_setup->m_node.chain.get(), test_setup->m_node.coinjoin_loader.get(), "", CreateDummyWalletDatabase());
+    wallet.SetupLegacyScriptPubKeyMan();
+    LOCK(wallet.cs_wallet);
+
+    CTxDestination dest;
+    std::string error;
+    const bool destination_ok = wallet.GetNewDestination("", dest, error);
+    assert(destination_ok);
+    const CScript script_pub_key{GetScriptForDestination(dest)};
+
+    // 50k denominated outputs next to 50k non-denominated ones
+    constexpr auto denoms{CoinJoin::GetStandardDenominations()};
+    for (int i = 0; i < 50000; ++i) {
+        CMutableTransaction tx;
+        tx.nLockTime = i; // so all transactions get different hashes
+        tx.vout.resize(2);
+        tx.vout[0].nValue = denoms[i % denoms.size()];
+        tx.vout[0].scriptPubKey = script_pub_key;
+        tx.vout[1].nValue = 7 * COIN;
+        tx.vout[1].scriptPubKey = script_pub_key;
+        wallet.AddToWallet(MakeTransactionRef(std::move(tx)), /* confirm= */ {});
+    }
+
+    bench.run([&] {
+        int count{0};
+        for (const auto denom : denoms) {
+            count += wallet.CountInputsWithAmount(denom);
+        }
+        assert(count == 50000);
+    });
+}
+
 BENCHMARK(CoinSelection);
 BENCHMARK(BnBExhaustion);
+BENCHMARK(CoinJoinCountInputsWithAmount);
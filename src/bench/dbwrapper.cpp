@@ -0,0 +1,41 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <dbwrapper.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+
+#include <vector>
+
+// Mimics the evo db usage while connecting a block: values are written into the
+// current transaction which is then committed into the root transaction.
+static void DBTransactionNestedCommit(benchmark::Bench& bench)
+{
+    using RootTransaction = CDBTransaction<CDBWrapper, CDBBatch>;
+    using CurTransaction = CDBTransaction<RootTransaction, RootTransaction>;
+
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    CDBWrapper dbw(GetDataDir() / "bench_dbtransaction", 1 << 20, true, false, false);
+    CDBBatch batch(dbw);
+    RootTransaction root(dbw, batch);
+    CurTransaction cur(root, root);
+
+    FastRandomContext det_rand{true};
+    std::vector<uint256> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(det_rand.rand256());
+    }
+    const std::vector<uint8_t> value(500, 0x42);
+
+    bench.run([&] {
+        for (const auto& key : keys) {
+            cur.Write(std::make_pair(std::string("bench"), key), value);
+        }
+        cur.Commit();
+        root.Clear();
+    });
+}
+
+BENCHMARK(DBTransactionNestedCommit);
@@ -0,0 +1,71 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
+#include <chainparams.h>
+#include <llmq/commitment.h>
+#include <llmq/instantsend.h>
+#include <llmq/quorums.h>
+#include <llmq/signing.h>
+#include <random.h>
+#include <test/util/setup_common.h>
+#include <util/check.h>
+
+#include <map>
+
+// Verifies a batch of pending ISLOCKs the way CInstantSendManager::ProcessPendingInstantSendLocks does once
+// CQuorumManager::ScanQuorums is served from its cache: every lock gets its quorum selected out of the active quorums,
+// its sign hash built and its signature pushed to the batch verifier.
+static void InstantSendLockBatchVerify(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    const auto& llmq_params = *Assert(Params().GetLLMQ(Params().GetConsensus().llmqTypeDIP0024InstantSend));
+    constexpr size_t num_locks{300};
+    constexpr size_t num_peers{8};
+
+    CBLSWorker bls_worker;
+    std::vector<llmq::CQuorumCPtr> quorums;
+    std::map<uint256, CBLSSecretKey> quorum_keys;
+    for (int i = 0; i < llmq_params.signingActiveQuorumCount; ++i) {
+        auto qc = std::make_unique<llmq::CFinalCommitment>(llmq_params, GetRandHash());
+        qc->quorumIndex = i;
+        CBLSSecretKey sk;
+        sk.MakeNewKey();
+        qc->quorumPublicKey = sk.GetPublicKey();
+        quorum_keys.emplace(qc->quorumHash, sk);
+        auto quorum = std::make_shared<llmq::CQuorum>(llmq_params, bls_worker);
+        quorum->Init(std::move(qc), nullptr, GetRandHash(), {});
+        quorums.push_back(quorum);
+    }
+
+    std::vector<std::pair<uint256, llmq::CInstantSendLockPtr>> pend;
+    for (size_t i = 0; i < num_locks; ++i) {
+        auto islock = std::make_shared<llmq::CInstantSendLock>();
+        islock->inputs.emplace_back(GetRandHash(), 0);
+        islock->txid = GetRandHash();
+        islock->cycleHash = GetRandHash();
+        const uint256 id{islock->GetRequestId()};
+        const auto quorum = Assert(llmq::SelectQuorumFromScan(llmq_params, quorums, llmq_params.useRotation, id));
+        const uint256 sign_hash{llmq::BuildSignHash(llmq_params.type, quorum->qc->quorumHash, id, islock->txid)};
+        islock->sig.Set(quorum_keys.at(quorum->qc->quorumHash).Sign(sign_hash), bls::bls_legacy_scheme.load());
+        pend.emplace_back(::SerializeHash(*islock), islock);
+    }
+
+    bench.batch(num_locks).unit("islock").run([&] {
+        CBLSBatchVerifier<NodeId, uint256> batch_verifier(false, true, 8);
+        for (size_t i = 0; i < pend.size(); ++i) {
+            const auto& [hash, islock] = pend[i];
+            const uint256 id{islock->GetRequestId()};
+            const auto quorum = llmq::SelectQuorumFromScan(llmq_params, quorums, llmq_params.useRotation, id);
+            const uint256 sign_hash{llmq::BuildSignHash(llmq_params.type, quorum->qc->quorumHash, id, islock->txid)};
+            batch_verifier.PushMessage(NodeId(i % num_peers), hash, sign_hash, islock->sig.Get(), quorum->qc->quorumPublicKey);
+        }
+        batch_verifier.Verify();
+        assert(batch_verifier.badMessages.empty());
+    });
+}
+
+BENCHMARK(InstantSendLockBatchVerify);
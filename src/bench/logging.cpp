@@ -0,0 +1,51 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <logging.h>
+#include <test/util/setup_common.h>
+
+#include <thread>
+#include <vector>
+
+// Throughput of debug.log output with several threads logging at once. The
+// calling threads only queue messages, the file is written by the background
+// writer thread.
+static void LogFileContended(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    constexpr int num_threads{4};
+    constexpr int lines_per_thread{250};
+
+    BCLog::Logger logger;
+    logger.m_print_to_file = true;
+    logger.m_file_path = testing_setup->m_path_root / "bench_debug.log";
+    if (!logger.StartLogging()) assert(false);
+
+    bench.batch(num_threads * lines_per_thread).unit("message").run([&] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&logger] {
+                for (int i = 0; i < lines_per_thread; ++i) {
+                    logger.LogPrintStr("GetColoredVout 1 BPayZZ00000000000000000000000000000\n");
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+
+    logger.DisconnectTestLogger();
+}
+
+// Cost of the per call site rate limit check done by every LogPrintf
+static void LogRateLimitCheck(benchmark::Bench& bench)
+{
+    BCLog::Logger logger;
+    bench.run([&] {
+        logger.AllowCallSite(__FILE__, __LINE__);
+    });
+}
+
+BENCHMARK(LogFileContended);
+BENCHMARK(LogRateLimitCheck);
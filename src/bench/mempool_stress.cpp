@@ -3,7 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <coins.h>
 #include <policy/policy.h>
+#include <script/standard.h>
 #include <test/util/setup_common.h>
 #include <txmempool.h>
 
@@ -89,4 +91,47 @@ static void ComplexMemPool(benchmark::Bench& bench)
     });
 }
 
+// Mempool churn with -addressindex and -spentindex: every transaction is indexed when it
+// enters the mempool and removed from the indexes again when it is mined.
+static void MempoolAddressSpentIndex(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(CBaseChainParams::MAIN);
+    FastRandomContext det_rand{true};
+
+    std::vector<CScript> scripts;
+    for (int i = 0; i < 200; ++i) {
+        scripts.push_back(GetScriptForDestination(PKHash(uint160(det_rand.randbytes(20)))));
+    }
+
+    CCoinsView base_view;
+    CCoinsViewCache view(&base_view);
+    std::vector<CTxMemPoolEntry> entries;
+    LockPoints lp;
+    for (int i = 0; i < 2000; ++i) {
+        CMutableTransaction tx;
+        for (int j = 0; j < 2; ++j) {
+            const COutPoint prevout(det_rand.rand256(), j);
+            view.AddCoin(prevout, Coin(CTxOut(10 * COIN, scripts[det_rand.randrange(scripts.size())]), 1, false), false);
+            tx.vin.emplace_back(prevout);
+        }
+        for (int j = 0; j < 2; ++j) {
+            tx.vout.emplace_back(5 * COIN, scripts[det_rand.randrange(scripts.size())]);
+        }
+        entries.emplace_back(MakeTransactionRef(tx), 1000, 0, 1, false, 4, lp);
+    }
+
+    CTxMemPool pool;
+    bench.run([&] {
+        for (const auto& entry : entries) {
+            pool.addAddressIndex(entry, view);
+            pool.addSpentIndex(entry, view);
+        }
+        for (const auto& entry : entries) {
+            pool.removeAddressIndex(entry.GetTx().GetHash());
+            pool.removeSpentIndex(entry.GetTx().GetHash());
+        }
+    });
+}
+
 BENCHMARK(ComplexMemPool);
+BENCHMARK(MempoolAddressSpentIndex);
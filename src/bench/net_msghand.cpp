@@ -0,0 +1,96 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <net.h>
+#include <net_processing.h>
+#include <netmessagemaker.h>
+#include <protocol.h>
+#include <random.h>
+#include <test/util/net.h>
+#include <test/util/setup_common.h>
+
+#include <thread>
+
+// Drive 16 peers through PeerManager::ProcessMessages, with the peers split
+// across num_threads threads by id the way -msghandthreads shards them. Every
+// peer sends pings and getdata requests for unknown transactions, which are
+// the messages that may be processed for several peers concurrently.
+static void MessageHandlerThreads(benchmark::Bench& bench, int num_threads)
+{
+    constexpr int num_peers{16};
+    constexpr int msgs_per_peer{20};
+
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>();
+    const auto& node_ctx = testing_setup->m_node;
+    auto connman = std::make_unique<ConnmanTestMsg>(0x1337, 0x1337, *node_ctx.addrman);
+    auto peerman = PeerManager::make(Params(), *connman, *node_ctx.addrman, nullptr, *node_ctx.scheduler,
+                                     *node_ctx.chainman, *node_ctx.mempool, *node_ctx.govman, node_ctx.cj_ctx,
+                                     node_ctx.llmq_ctx, false);
+    CConnman::Options options;
+    options.m_msgproc = peerman.get();
+    options.nMsgHandThreads = num_threads;
+    options.nSendBufferMaxSize = 1000 * DEFAULT_MAXSENDBUFFER;
+    options.nReceiveFloodSize = 1000 * DEFAULT_MAXRECEIVEBUFFER;
+    connman->Init(options);
+
+    std::vector<CNode*> nodes;
+    for (NodeId id = 0; id < num_peers; ++id) {
+        CAddress addr(CService(CNetAddr(), 7777 + id), NODE_NETWORK);
+        CNode* node = new CNode(id, NODE_NETWORK, INVALID_SOCKET, addr, 0, 0, CAddress(), "", ConnectionType::OUTBOUND_FULL_RELAY);
+        node->nVersion = PROTOCOL_VERSION;
+        node->SetCommonVersion(PROTOCOL_VERSION);
+        peerman->InitializeNode(node);
+        node->fSuccessfullyConnected = true;
+        connman->AddTestNode(*node);
+        nodes.push_back(node);
+    }
+
+    const CNetMsgMaker msg_maker(PROTOCOL_VERSION);
+    std::vector<CInv> unknown_txs;
+    for (int i = 0; i < 8; ++i) {
+        unknown_txs.emplace_back(MSG_TX, GetRandHash());
+    }
+
+    bench.batch(num_peers * msgs_per_peer).unit("message").run([&] {
+        for (CNode* node : nodes) {
+            for (int i = 0; i < msgs_per_peer; ++i) {
+                CSerializedNetMsg msg{i % 2 == 0 ? msg_maker.Make(NetMsgType::PING, uint64_t(i)) : msg_maker.Make(NetMsgType::GETDATA, unknown_txs)};
+                connman->ReceiveMsgFrom(*node, msg);
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (int shard = 0; shard < num_threads; ++shard) {
+            threads.emplace_back([&, shard] {
+                for (bool more_work = true; more_work;) {
+                    more_work = false;
+                    for (CNode* node : nodes) {
+                        if (node->GetId() % num_threads != shard) continue;
+                        more_work |= connman->ProcessMessagesOnce(*node);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        for (CNode* node : nodes) {
+            LOCK(node->cs_vSend);
+            node->vSendMsg.clear();
+            node->nSendSize = 0;
+            node->fPauseSend = false;
+        }
+    });
+
+    for (CNode* node : nodes) {
+        peerman->FinalizeNode(*node);
+    }
+    connman->ClearTestNodes();
+}
+
+static void MessageHandlerOneThread(benchmark::Bench& bench) { MessageHandlerThreads(bench, 1); }
+static void MessageHandlerFourThreads(benchmark::Bench& bench) { MessageHandlerThreads(bench, 4); }
+
+BENCHMARK(MessageHandlerOneThread);
+BENCHMARK(MessageHandlerFourThreads);
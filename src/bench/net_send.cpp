@@ -0,0 +1,48 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <net.h>
+#include <netmessagemaker.h>
+#include <protocol.h>
+#include <test/util/net.h>
+#include <test/util/setup_common.h>
+
+#ifndef WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Flush a burst of small messages, like inv and sig share announcements, over
+// a local socket pair and drain them on the other end.
+static void SocketSendDataSmallMessages(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>();
+    auto connman = std::make_unique<ConnmanTestMsg>(0x1337, 0x1337, *testing_setup->m_node.addrman);
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) assert(false);
+
+    CAddress addr(CService(CNetAddr(), 7777), NODE_NETWORK);
+    auto node = std::make_unique<CNode>(0, NODE_NETWORK, sockets[0], addr, 0, 0, CAddress(), "", ConnectionType::OUTBOUND_FULL_RELAY);
+    const CNetMsgMaker msg_maker(PROTOCOL_VERSION);
+    const std::vector<CInv> inv{CInv(MSG_TX, uint256::ONE)};
+
+    std::vector<unsigned char> recv_buf(1 << 16);
+    bench.run([&] {
+        for (int i = 0; i < 100; ++i) {
+            connman->PushMessage(node.get(), msg_maker.Make(NetMsgType::INV, inv));
+        }
+        LOCK(node->cs_vSend);
+        while (!node->vSendMsg.empty()) {
+            connman->SocketSendData(node.get());
+            while (recv(sockets[1], recv_buf.data(), recv_buf.size(), MSG_DONTWAIT) > 0) {}
+        }
+    });
+
+    node.reset();
+    close(sockets[1]);
+}
+
+BENCHMARK(SocketSendDataSmallMessages);
+#endif // WIN32
@@ -0,0 +1,47 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <context.h>
+#include <rpc/request.h>
+#include <rpc/server.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <univalue.h>
+
+// A batch as sent by indexers: many read-only lookups in one request
+static UniValue MakeBatch(const uint256& block_hash, size_t count)
+{
+    UniValue batch(UniValue::VARR);
+    for (size_t i = 0; i < count; ++i) {
+        UniValue req(UniValue::VOBJ);
+        req.pushKV("id", int(i));
+        req.pushKV("method", "getblock");
+        UniValue params(UniValue::VARR);
+        params.push_back(block_hash.GetHex());
+        params.push_back(2);
+        req.pushKV("params", params);
+        batch.push_back(req);
+    }
+    return batch;
+}
+
+static void RpcBatch(benchmark::Bench& bench)
+{
+    const auto test_setup = MakeNoLogFileContext<TestingSetup>();
+    if (RPCIsInWarmup(nullptr)) SetRPCWarmupFinished();
+
+    const uint256 genesis_hash{WITH_LOCK(cs_main, return test_setup->m_node.chainman->ActiveChain().Genesis()->GetBlockHash())};
+    const UniValue batch{MakeBatch(genesis_hash, 500)};
+    CoreContext context{test_setup->m_node};
+    JSONRPCRequest jreq(context);
+
+    bench.run([&] {
+        const std::string reply{JSONRPCExecBatch(jreq, batch)};
+        assert(!reply.empty());
+    });
+}
+
+BENCHMARK(RpcBatch);
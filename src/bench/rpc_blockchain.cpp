@@ -3,14 +3,16 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
-#include <bench/data.h>
 
+#include <consensus/merkle.h>
 #include <consensus/validation.h>
 #include <llmq/chainlocks.h>
 #include <llmq/context.h>
 #include <llmq/instantsend.h>
+#include <primitives/transaction.h>
+#include <random.h>
 #include <rpc/blockchain.h>
-#include <streams.h>
+#include <script/script.h>
 #include <test/util/setup_common.h>
 #include <validation.h>
 
@@ -26,11 +28,26 @@ struct TestBlockAndIndex {
 
     TestBlockAndIndex()
     {
-        CDataStream stream(benchmark::data::block813851, SER_NETWORK, PROTOCOL_VERSION);
-        std::byte a{0};
-        stream.write({&a, 1}); // Prevent compaction
-
-        stream >> block;
+        // benchmark::data::block813851 is a Dash block, which does not deserialize with BiblePay's CTxOut,
+        // so build a block of the same order of size instead
+        FastRandomContext rng{/* fDeterministic */ true};
+        CMutableTransaction coinbase;
+        coinbase.vin.resize(1);
+        coinbase.vin[0].prevout.SetNull();
+        coinbase.vin[0].scriptSig = CScript() << 813851 << OP_0;
+        coinbase.vout.emplace_back(5 * COIN, CScript() << OP_DUP << OP_HASH160 << rng.randbytes(20) << OP_EQUALVERIFY << OP_CHECKSIG);
+        block.vtx.push_back(MakeTransactionRef(coinbase));
+        for (int i = 0; i < 2500; ++i) {
+            CMutableTransaction tx;
+            for (int j = 0; j < 2; ++j) {
+                tx.vin.emplace_back(COutPoint(rng.rand256(), j), CScript() << rng.randbytes(72) << rng.randbytes(33));
+            }
+            for (int j = 0; j < 2; ++j) {
+                tx.vout.emplace_back(rng.randrange(100 * COIN), CScript() << OP_DUP << OP_HASH160 << rng.randbytes(20) << OP_EQUALVERIFY << OP_CHECKSIG);
+            }
+            block.vtx.push_back(MakeTransactionRef(tx));
+        }
+        block.hashMerkleRoot = BlockMerkleRoot(block);
 
         blockHash = block.GetHash();
         blockindex.phashBlock = &blockHash;
@@ -64,3 +81,15 @@ static void BlockToJsonVerboseWrite(benchmark::Bench& bench)
 }
 
 BENCHMARK(BlockToJsonVerboseWrite);
+
+static void BlockToJsonStringVerbose(benchmark::Bench& bench)
+{
+    TestBlockAndIndex data;
+    const LLMQContext& llmq_ctx = *data.testing_setup->m_node.llmq_ctx;
+    bench.run([&] {
+        auto str = blockToJSONString(data.block, &data.blockindex, &data.blockindex, *llmq_ctx.clhandler, *llmq_ctx.isman, /*verbose*/ true);
+        ankerl::nanobench::doNotOptimizeAway(str);
+    });
+}
+
+BENCHMARK(BlockToJsonStringVerbose);
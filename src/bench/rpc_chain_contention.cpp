@@ -0,0 +1,88 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chain.h>
+#include <context.h>
+#include <rpc/server.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <univalue.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Read-only chain RPCs served while another thread keeps connecting blocks.
+// The connecting thread holds cs_main for a millisecond per block and moves
+// the active tip back and forth, so every call that waits for cs_main shows
+// up in the result.
+static void RpcChainReadContended(benchmark::Bench& bench)
+{
+    const auto test_setup = std::make_unique<TestChainSetup>(100, std::vector<const char*>{"-nodebuglogfile", "-nodebug"});
+    if (RPCIsInWarmup(nullptr)) SetRPCWarmupFinished();
+
+    ChainstateManager& chainman = *test_setup->m_node.chainman;
+    CBlockIndex* const tip{WITH_LOCK(cs_main, return chainman.ActiveTip())};
+    const uint256 genesis_hash{WITH_LOCK(cs_main, return chainman.ActiveChain().Genesis()->GetBlockHash())};
+
+    std::atomic<bool> stop{false};
+    std::thread connect_thread([&] {
+        while (!stop) {
+            {
+                LOCK(cs_main);
+                CChain& active_chain = chainman.ActiveChain();
+                active_chain.SetTip(tip->pprev);
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                active_chain.SetTip(tip);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    CoreContext context{test_setup->m_node};
+    JSONRPCRequest headers_req(context);
+    headers_req.strMethod = "getblockheaders";
+    headers_req.params = UniValue(UniValue::VARR);
+    headers_req.params.push_back(genesis_hash.GetHex());
+    headers_req.params.push_back(50);
+    headers_req.params.push_back(false);
+
+    JSONRPCRequest stats_req(context);
+    stats_req.strMethod = "getblockstats";
+    stats_req.params = UniValue(UniValue::VARR);
+    stats_req.params.push_back(50);
+
+    bench.run([&] {
+        const UniValue headers{tableRPC.execute(headers_req)};
+        assert(headers.size() == 50);
+        const UniValue stats{tableRPC.execute(stats_req)};
+        assert(stats["height"].get_int() == 50);
+    });
+
+    stop = true;
+    connect_thread.join();
+}
+
+// Cost added to every tip change by publishing a new snapshot of a long chain
+static void ChainSnapshotUpdate(benchmark::Bench& bench)
+{
+    std::vector<CBlockIndex> blocks(500000);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i].nHeight = i;
+        blocks[i].pprev = i ? &blocks[i - 1] : nullptr;
+    }
+    CChain chain;
+    chain.SetTip(&blocks.back());
+
+    bool at_tip{true};
+    bench.run([&] {
+        chain.SetTip(at_tip ? &blocks[blocks.size() - 2] : &blocks.back());
+        at_tip = !at_tip;
+    });
+}
+
+BENCHMARK(RpcChainReadContended);
+BENCHMARK(ChainSnapshotUpdate);
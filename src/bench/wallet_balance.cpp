@@ -3,16 +3,23 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <coinjoin/common.h>
+#include <crypto/common.h>
 #include <interfaces/chain.h>
+#include <key_io.h>
 #include <node/context.h>
 #include <test/util/mining.h>
 #include <test/util/setup_common.h>
 #include <test/util/wallet.h>
 #include <validationinterface.h>
+#include <wallet/coincontrol.h>
 #include <wallet/wallet.h>
 
 #include <optional>
 
+//! Size of the wallet in the *Large benchmarks
+static constexpr int LARGE_WALLET_TX_COUNT{500000};
+
 static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const bool add_watchonly, const bool add_mine, const uint32_t epoch_iters)
 {
     const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
@@ -38,13 +45,99 @@ static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const b
     auto bal = wallet.GetBalance(); // Cache
 
     bench.minEpochIterations(epoch_iters).run([&] {
-        if (set_dirty) wallet.MarkDirty();
+        // MarkDirty() also drops the per-transaction credit caches, MarkBalanceDirty() is what a new block does
+        if (set_dirty) {
+            wallet.MarkDirty();
+        } else {
+            LOCK(wallet.cs_wallet);
+            wallet.MarkBalanceDirty();
+        }
         bal = wallet.GetBalance();
         if (add_mine) assert(bal.m_mine_trusted > 0);
         if (add_watchonly) assert(bal.m_watchonly_trusted > 0);
     });
 }
 
+static void WalletAvailableCoins(benchmark::Bench& bench)
+{
+    const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
+
+    CWallet wallet{test_setup->m_node.chain.get(), test_setup->m_node.coinjoin_loader.get(), "", CreateMockWalletDatabase()};
+    {
+        wallet.SetupLegacyScriptPubKeyMan();
+        bool first_run;
+        if (wallet.LoadWallet(first_run) != DBErrors::LOAD_OK) assert(false);
+    }
+    auto handler = test_setup->m_node.chain->handleNotifications({&wallet, [](CWallet*) {}});
+
+    const std::string address_mine{getnewaddress(wallet)};
+    for (int i = 0; i < 200; ++i) {
+        generatetoaddress(test_setup->m_node, address_mine);
+    }
+    SyncWithValidationInterfaceQueue();
+
+    bench.minEpochIterations(100).run([&] {
+        LOCK(wallet.cs_wallet);
+        std::vector<COutput> coins;
+        wallet.AvailableCoins(coins);
+        assert(!coins.empty());
+    });
+}
+
+/** Build a wallet of LARGE_WALLET_TX_COUNT confirmed single output transactions without mining them,
+ *  every fifth output is a CoinJoin denomination. */
+static void CreateLargeWallet(const TestingSetup& test_setup, CWallet& wallet)
+{
+    wallet.SetupLegacyScriptPubKeyMan();
+    bool first_run;
+    if (wallet.LoadWallet(first_run) != DBErrors::LOAD_OK) assert(false);
+
+    const CScript script_mine{GetScriptForDestination(DecodeDestination(getnewaddress(wallet)))};
+    const int height{*test_setup.m_node.chain->getHeight()};
+    const uint256 block_hash{test_setup.m_node.chain->getBlockHash(height)};
+    const auto denoms{CoinJoin::GetStandardDenominations()};
+
+    LOCK(wallet.cs_wallet);
+    wallet.SetLastBlockProcessed(height, block_hash);
+    for (int i = 0; i < LARGE_WALLET_TX_COUNT; ++i) {
+        uint256 prev_hash;
+        WriteLE32(prev_hash.begin(), i);
+        CMutableTransaction mtx;
+        mtx.vin.emplace_back(COutPoint(prev_hash, 0));
+        mtx.vout.emplace_back(i % 5 == 0 ? denoms[(i / 5) % denoms.size()] : COIN, script_mine);
+        wallet.AddToWallet(MakeTransactionRef(std::move(mtx)), CWalletTx::Confirmation(CWalletTx::CONFIRMED, height, block_hash, i));
+    }
+}
+
+static void WalletBalanceLarge(benchmark::Bench& bench)
+{
+    const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
+    CWallet wallet{test_setup->m_node.chain.get(), test_setup->m_node.coinjoin_loader.get(), "", CreateMockWalletDatabase()};
+    CreateLargeWallet(*test_setup, wallet);
+
+    bench.minEpochIterations(1).run([&] {
+        LOCK(wallet.cs_wallet);
+        wallet.MarkBalanceDirty();
+        assert(wallet.GetBalance().m_mine_trusted > 0);
+    });
+}
+
+static void WalletAvailableCoinsLarge(benchmark::Bench& bench, const CoinType coin_type)
+{
+    const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
+    CWallet wallet{test_setup->m_node.chain.get(), test_setup->m_node.coinjoin_loader.get(), "", CreateMockWalletDatabase()};
+    CreateLargeWallet(*test_setup, wallet);
+
+    CCoinControl coin_control;
+    coin_control.nCoinType = coin_type;
+    bench.minEpochIterations(1).run([&] {
+        LOCK(wallet.cs_wallet);
+        std::vector<COutput> coins;
+        wallet.AvailableCoins(coins, /* fOnlySafe */ true, &coin_control);
+        assert(!coins.empty());
+    });
+}
+
 static void WalletBalanceDirty(benchmark::Bench& bench) { WalletBalance(bench, /* set_dirty */ true, /* add_watchonly */ true, /* add_mine */ true, 2500); }
 static void WalletBalanceClean(benchmark::Bench& bench) {WalletBalance(bench, /* set_dirty */ false, /* add_watchonly */ true, /* add_mine */ true, 8000); }
 static void WalletBalanceMine(benchmark::Bench& bench) { WalletBalance(bench, /* set_dirty */ false, /* add_watchonly */ false, /* add_mine */ true, 16000); }
@@ -54,3 +147,10 @@ BENCHMARK(WalletBalanceDirty);
 BENCHMARK(WalletBalanceClean);
 BENCHMARK(WalletBalanceMine);
 BENCHMARK(WalletBalanceWatch);
+static void WalletAvailableCoinsLargeAll(benchmark::Bench& bench) { WalletAvailableCoinsLarge(bench, CoinType::ALL_COINS); }
+static void WalletAvailableCoinsLargeDenominated(benchmark::Bench& bench) { WalletAvailableCoinsLarge(bench, CoinType::ONLY_READY_TO_MIX); }
+
+BENCHMARK(WalletAvailableCoins);
+BENCHMARK(WalletBalanceLarge);
+BENCHMARK(WalletAvailableCoinsLargeAll);
+BENCHMARK(WalletAvailableCoinsLargeDenominated);
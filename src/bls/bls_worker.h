@@ -161,6 +161,14 @@ public:
             return CBLSWorker::BuildPubKeyShare(vvec, id);
         });
     }
+    // Seeds the cache with a public key share which was built before (e.g. loaded from disk)
+    void SetPubKeyShare(const uint256& cacheKey, const CBLSPublicKey& pubKeyShare)
+    {
+        std::promise<CBLSPublicKey> p;
+        p.set_value(pubKeyShare);
+        std::lock_guard<std::mutex> l(cacheCs);
+        publicKeyShareCache.emplace(cacheKey, p.get_future());
+    }
 
 private:
     template <typename T, typename Builder>
@@ -31,6 +31,7 @@ std::string CBlockIndex::ToString() const
 void CChain::SetTip(CBlockIndex *pindex) {
     if (pindex == nullptr) {
         vChain.clear();
+        UpdateSnapshot();
         return;
     }
     vChain.resize(pindex->nHeight + 1);
@@ -38,6 +39,29 @@ void CChain::SetTip(CBlockIndex *pindex) {
         vChain[pindex->nHeight] = pindex;
         pindex = pindex->pprev;
     }
+    UpdateSnapshot();
+}
+
+void CChain::UpdateSnapshot() {
+    const auto prev_snapshot = GetSnapshot();
+    const CChainSnapshot& prev = *prev_snapshot;
+    auto snapshot = std::make_shared<CChainSnapshot>();
+    snapshot->m_height = Height();
+    const size_t nChunks = (vChain.size() + CChainSnapshot::CHUNK_SIZE - 1) / CChainSnapshot::CHUNK_SIZE;
+    snapshot->m_chunks.reserve(nChunks);
+    for (size_t i = 0; i < nChunks; ++i) {
+        const size_t begin = i * CChainSnapshot::CHUNK_SIZE;
+        const size_t end = std::min(begin + CChainSnapshot::CHUNK_SIZE, vChain.size());
+        // A full chunk whose last entry is unchanged is unchanged as a whole,
+        // as every entry is the pprev of the one above it.
+        if (end - begin == CChainSnapshot::CHUNK_SIZE && i < prev.m_chunks.size() &&
+            prev.m_chunks[i]->size() == CChainSnapshot::CHUNK_SIZE && prev.m_chunks[i]->back() == vChain[end - 1]) {
+            snapshot->m_chunks.push_back(prev.m_chunks[i]);
+        } else {
+            snapshot->m_chunks.push_back(std::make_shared<const CChainSnapshot::Chunk>(vChain.begin() + begin, vChain.begin() + end));
+        }
+    }
+    std::atomic_store(&m_snapshot, std::shared_ptr<const CChainSnapshot>(std::move(snapshot)));
 }
 
 CBlockLocator CChain::GetLocator(const CBlockIndex *pindex) const {
@@ -79,6 +103,17 @@ const CBlockIndex *CChain::FindFork(const CBlockIndex *pindex) const {
     return pindex;
 }
 
+const CBlockIndex *CChainSnapshot::FindFork(const CBlockIndex *pindex) const {
+    if (pindex == nullptr) {
+        return nullptr;
+    }
+    if (pindex->nHeight > Height())
+        pindex = pindex->GetAncestor(Height());
+    while (pindex && !Contains(pindex))
+        pindex = pindex->pprev;
+    return pindex;
+}
+
 CBlockIndex* CChain::FindEarliestAtLeast(int64_t nTime, int height) const
 {
     std::pair<int64_t, int> blockparams = std::make_pair(nTime, height);
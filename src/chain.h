@@ -12,6 +12,7 @@
 #include <primitives/block.h>
 #include <uint256.h>
 
+#include <memory>
 #include <vector>
 
 /**
@@ -378,10 +379,60 @@ public:
 
 };
 
+/**
+ * An immutable copy of a CChain as of one tip, which can be read without
+ * cs_main. Block index entries are never freed while the node runs and their
+ * header fields (hash, height, pprev, nTime, nBits, ...) do not change once
+ * the entry is in the index. Fields such as nStatus or the disk positions are
+ * still guarded by cs_main.
+ *
+ * The entries are stored in fixed-size chunks that are shared with the
+ * previous snapshot when they did not change, so publishing a new tip only
+ * copies the last chunk and the chunks touched by a reorg.
+ */
+class CChainSnapshot {
+public:
+    static constexpr int CHUNK_SIZE{4096};
+
+    CBlockIndex *Genesis() const { return (*this)[0]; }
+    CBlockIndex *Tip() const { return (*this)[m_height]; }
+
+    CBlockIndex *operator[](int nHeight) const {
+        if (nHeight < 0 || nHeight > m_height)
+            return nullptr;
+        return (*m_chunks[nHeight / CHUNK_SIZE])[nHeight % CHUNK_SIZE];
+    }
+
+    bool Contains(const CBlockIndex *pindex) const {
+        return (*this)[pindex->nHeight] == pindex;
+    }
+
+    CBlockIndex *Next(const CBlockIndex *pindex) const {
+        if (Contains(pindex))
+            return (*this)[pindex->nHeight + 1];
+        else
+            return nullptr;
+    }
+
+    int Height() const { return m_height; }
+
+    const CBlockIndex *FindFork(const CBlockIndex *pindex) const;
+
+private:
+    friend class CChain;
+    using Chunk = std::vector<CBlockIndex*>;
+
+    std::vector<std::shared_ptr<const Chunk>> m_chunks;
+    int m_height{-1};
+};
+
 /** An in-memory indexed chain of blocks. */
 class CChain {
 private:
     std::vector<CBlockIndex*> vChain;
+    std::shared_ptr<const CChainSnapshot> m_snapshot{std::make_shared<const CChainSnapshot>()};
+
+    void UpdateSnapshot();
 
 public:
     /** Returns the index entry for the genesis block of this chain, or nullptr if none. */
@@ -422,6 +473,11 @@ public:
     /** Set/initialize a chain with a given tip. */
     void SetTip(CBlockIndex *pindex);
 
+    /** Return an immutable view of this chain as of the last SetTip(). Does not require cs_main. */
+    std::shared_ptr<const CChainSnapshot> GetSnapshot() const {
+        return std::atomic_load(&m_snapshot);
+    }
+
     /** Return a CBlockLocator that refers to a block in this chain (by default the tip). */
     CBlockLocator GetLocator(const CBlockIndex *pindex = nullptr) const;
 
@@ -20,6 +20,7 @@
 #include <arith_uint256.h>
 
 #include <assert.h>
+#include <limits>
 
 static CBlock CreateGenesisBlock(const char* pszTimestamp, const CScript& genesisOutputScript, uint32_t nTime, uint32_t nNonce, uint32_t nBits, int32_t nVersion, const CAmount& genesisReward)
 {
@@ -783,6 +784,19 @@ class CRegTestParams : public CChainParams {
 public:
     explicit CRegTestParams(const ArgsManager& args) {
         strNetworkID =  CBaseChainParams::REGTEST;
+        // BiblePay forks are active from genesis on regtest, except for the v6 block rules in CheckProofOfWork
+        consensus.GREAT_AWAKENING_HEIGHT = 0;
+        consensus.BABYLON_FALLING_HEIGHT = 0;
+        consensus.BABYLON_FALLING_TIME = std::numeric_limits<int>::max();
+        consensus.HAMANS_HANGING_HEIGHT = 0;
+        consensus.BARLEY_HARVEST_HEIGHT = 0;
+        consensus.BARLEY_HARVEST_HEIGHT2 = 0;
+        consensus.EXODUS_HEIGHT = 0;
+        consensus.REDSEA_HEIGHT = 0;
+        consensus.LATTER_RAIN_HEIGHT = 0;
+        consensus.REDSEA_PARTING = 0;
+        consensus.RANDOMX_HEIGHT = 0;
+        consensus.LLMQHeight = 0;
         consensus.nSubsidyHalvingInterval = 150;
         consensus.BIP16Height = 0; // always enforce P2SH BIP16 on regtest
         consensus.nMasternodePaymentsStartBlock = 240;
@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <random.h>
+#include <sync.h>
+#include <util/string.h>
 
 #include <leveldb/cache.h>
 #include <leveldb/env.h>
@@ -14,6 +16,7 @@
 #include <stdint.h>
 #include <algorithm>
 #include <optional>
+#include <set>
 
 class CBitcoinLevelDBLogger : public leveldb::Logger {
 public:
@@ -98,12 +101,70 @@ static void SetMaxOpenFiles(leveldb::Options *options) {
              options->max_open_files, default_open_files);
 }
 
-static leveldb::Options GetOptions(size_t nCacheSize)
+bool ApplyDBProfileArgs(const ArgsManager& args, const std::string& name, DBProfile& profile, std::string& error)
+{
+    for (const std::string& arg : args.GetArgs("-dbprofile")) {
+        const auto colon = arg.find(':');
+        if (colon == std::string::npos || colon == 0) {
+            error = strprintf("Invalid -dbprofile=%s, expected <name>:<option>=<value>[,...]", arg);
+            return false;
+        }
+        const bool matches{arg.compare(0, colon, name) == 0 && colon == name.size()};
+        for (const std::string& option : SplitString(arg.substr(colon + 1), ',')) {
+            const auto eq = option.find('=');
+            int32_t value;
+            if (eq == std::string::npos || !ParseInt32(option.substr(eq + 1), &value) || value < 0) {
+                error = strprintf("Invalid -dbprofile option '%s' for %s", option, arg.substr(0, colon));
+                return false;
+            }
+            const std::string key{option.substr(0, eq)};
+            int* field{nullptr};
+            if (key == "blockcache") {
+                field = &profile.block_cache_percent;
+            } else if (key == "writebuffer") {
+                field = &profile.write_buffer_percent;
+            } else if (key == "bloombits") {
+                field = &profile.bloom_bits;
+            } else if (key == "maxfilesize") {
+                field = &profile.max_file_size_mb;
+            } else {
+                error = strprintf("Unknown -dbprofile option '%s' for %s (supported: blockcache, writebuffer, bloombits, maxfilesize)", key, arg.substr(0, colon));
+                return false;
+            }
+            if (matches) *field = value;
+        }
+    }
+    if (profile.block_cache_percent + 2 * profile.write_buffer_percent > 100) {
+        error = strprintf("Invalid -dbprofile for %s: blockcache plus two write buffers exceed 100%% of the cache", name);
+        return false;
+    }
+    return true;
+}
+
+static Mutex g_open_dbs_mutex;
+//! Databases reported by GetDBWrapperInfo(), registered once they are opened
+static std::set<const CDBWrapper*> g_open_dbs GUARDED_BY(g_open_dbs_mutex);
+
+std::vector<DBWrapperInfo> GetDBWrapperInfo()
+{
+    LOCK(g_open_dbs_mutex);
+    std::vector<DBWrapperInfo> result;
+    result.reserve(g_open_dbs.size());
+    for (const CDBWrapper* db : g_open_dbs) {
+        result.push_back(db->GetInfo());
+    }
+    return result;
+}
+
+static leveldb::Options GetOptions(size_t nCacheSize, const DBProfile& profile)
 {
     leveldb::Options options;
-    options.block_cache = leveldb::NewLRUCache(nCacheSize / 2);
-    options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
-    options.filter_policy = leveldb::NewBloomFilterPolicy(10);
+    options.block_cache = leveldb::NewLRUCache(nCacheSize * profile.block_cache_percent / 100);
+    options.write_buffer_size = nCacheSize * profile.write_buffer_percent / 100; // up to two write buffers may be held in memory simultaneously
+    options.filter_policy = profile.bloom_bits > 0 ? leveldb::NewBloomFilterPolicy(profile.bloom_bits) : nullptr;
+    if (profile.max_file_size_mb > 0) {
+        options.max_file_size = size_t(profile.max_file_size_mb) << 20;
+    }
     options.compression = leveldb::kNoCompression;
     options.info_log = new CBitcoinLevelDBLogger();
     if (leveldb::kMajorVersion > 1 || (leveldb::kMajorVersion == 1 && leveldb::kMinorVersion >= 16)) {
@@ -116,14 +177,22 @@ static leveldb::Options GetOptions(size_t nCacheSize)
 }
 
 CDBWrapper::CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory, bool fWipe, bool obfuscate)
-    : m_name{path.stem().string()}
+    : m_name{path.stem().string()}, m_cache_size{nCacheSize}
 {
     penv = nullptr;
     readoptions.verify_checksums = true;
     iteroptions.verify_checksums = true;
     iteroptions.fill_cache = false;
     syncoptions.sync = true;
-    options = GetOptions(nCacheSize);
+    std::string profile_error;
+    if (!ApplyDBProfileArgs(gArgs, m_name, m_profile, profile_error)) {
+        // arguments are validated on startup, this is only reachable when opening databases without init
+        LogPrintf("%s, using default settings for %s\n", profile_error, m_name);
+        m_profile = DBProfile{};
+    }
+    LogPrint(BCLog::LEVELDB, "LevelDB profile for %s: cache=%d blockcache=%d%% writebuffer=%d%% bloombits=%d maxfilesize=%d\n",
+             m_name, nCacheSize, m_profile.block_cache_percent, m_profile.write_buffer_percent, m_profile.bloom_bits, m_profile.max_file_size_mb);
+    options = GetOptions(nCacheSize, m_profile);
     options.create_if_missing = true;
     if (fMemory) {
         penv = leveldb::NewMemEnv(leveldb::Env::Default());
@@ -165,10 +234,13 @@ CDBWrapper::CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory, bo
     }
 
     LogPrintf("Using obfuscation key for %s: %s\n", path.string(), HexStr(obfuscate_key));
+
+    WITH_LOCK(g_open_dbs_mutex, g_open_dbs.insert(this));
 }
 
 CDBWrapper::~CDBWrapper()
 {
+    WITH_LOCK(g_open_dbs_mutex, g_open_dbs.erase(this));
     delete pdb;
     pdb = nullptr;
     delete options.filter_policy;
@@ -209,6 +281,11 @@ size_t CDBWrapper::DynamicMemoryUsage() const
     return parsed.value();
 }
 
+DBWrapperInfo CDBWrapper::GetInfo() const
+{
+    return DBWrapperInfo{m_name, m_cache_size, m_profile, DynamicMemoryUsage()};
+}
+
 // Prefixed with null character to avoid collisions with other keys
 //
 // We must use a string constructor which specifies length so that we copy
@@ -29,6 +29,40 @@ public:
 
 class CDBWrapper;
 
+/**
+ * LevelDB tuning of a single database. The defaults can be overridden per database
+ * name (the last component of its path, e.g. "chainstate" or "evodb") with
+ * -dbprofile=<name>:<option>=<value>[,<option>=<value>...]
+ */
+struct DBProfile {
+    //! Share of the cache size used for the LevelDB block cache, in percent
+    int block_cache_percent{50};
+    //! Share of the cache size used for each of the (up to two) write buffers, in percent
+    int write_buffer_percent{25};
+    //! Bits per key of the bloom filter, 0 disables it
+    int bloom_bits{10};
+    //! Target size of table files in MiB, 0 keeps the LevelDB default
+    int max_file_size_mb{0};
+};
+
+/**
+ * Applies the -dbprofile settings for the database called name to profile.
+ * @returns false and sets error if an argument can't be parsed
+ */
+bool ApplyDBProfileArgs(const ArgsManager& args, const std::string& name, DBProfile& profile, std::string& error);
+
+/** Settings and memory usage of an open database, as reported by getmemoryinfo */
+struct DBWrapperInfo {
+    std::string name;
+    size_t cache_size;
+    DBProfile profile;
+    //! LevelDB's leveldb.approximate-memory-usage property, in bytes
+    size_t memory_usage;
+};
+
+/** Returns the settings of every currently open CDBWrapper */
+std::vector<DBWrapperInfo> GetDBWrapperInfo();
+
 /** These should be considered an implementation detail of the specific database.
  */
 namespace dbwrapper_private {
@@ -222,6 +256,10 @@ private:
     //! the name of this database
     std::string m_name;
 
+    //! the cache size and profile this database was opened with
+    size_t m_cache_size;
+    DBProfile m_profile;
+
     //! a key used for optional XOR-obfuscation of the database
     std::vector<unsigned char> obfuscate_key;
 
@@ -345,6 +383,8 @@ public:
     // Get an estimate of LevelDB memory usage (in bytes).
     size_t DynamicMemoryUsage() const;
 
+    DBWrapperInfo GetInfo() const;
+
     CDBIterator *NewIterator()
     {
         return new CDBIterator(*this, pdb->NewIterator(iteroptions));
@@ -557,18 +597,19 @@ protected:
         size_t memoryUsage;
         explicit ValueHolder(size_t _memoryUsage) : memoryUsage(_memoryUsage) {}
         virtual ~ValueHolder() = default;
-        virtual void Write(const CDataStream& ssKey, CommitTarget &parent) = 0;
+        virtual void Write(CDataStream&& ssKey, CommitTarget &parent) = 0;
     };
     typedef std::unique_ptr<ValueHolder> ValueHolderPtr;
 
     template <typename V>
     struct ValueHolderImpl : ValueHolder {
         ValueHolderImpl(const V &_value, size_t _memoryUsage) : ValueHolder(_memoryUsage), value(_value) {}
+        ValueHolderImpl(V &&_value, size_t _memoryUsage) : ValueHolder(_memoryUsage), value(std::move(_value)) {}
 
-        virtual void Write(const CDataStream& ssKey, CommitTarget &commitTarget) override {
-            // we're moving the value instead of copying it. This means that Write() can only be called once per
-            // ValueHolderImpl instance. Commit() clears the write maps, so this ok.
-            commitTarget.Write(ssKey, std::move(value));
+        virtual void Write(CDataStream&& ssKey, CommitTarget &commitTarget) override {
+            // we're moving the key and value instead of copying them. This means that Write() can only be called
+            // once per ValueHolderImpl instance. Commit() clears the write maps, so this ok.
+            commitTarget.Write(std::move(ssKey), std::move(value));
         }
         V value;
     };
@@ -597,18 +638,26 @@ public:
 
     template <typename V>
     void Write(const CDataStream& ssKey, const V& v) {
-        auto valueMemoryUsage = ::GetSerializeSize(v, CLIENT_VERSION);
+        Write(CDataStream(ssKey), v);
+    }
 
-        if (deletes.erase(ssKey)) {
-            memoryUsage -= ssKey.size();
+    /** Takes ownership of the key and, if passed as rvalue, the value. Used when a nested transaction is committed */
+    template <typename V>
+    void Write(CDataStream&& ssKey, V&& v) {
+        using ValueType = std::decay_t<V>;
+        const auto keyMemoryUsage = ssKey.size();
+        const auto valueMemoryUsage = ::GetSerializeSize(v, CLIENT_VERSION);
+
+        if (!deletes.empty() && deletes.erase(ssKey)) {
+            memoryUsage -= keyMemoryUsage;
         }
-        auto it = writes.emplace(ssKey, nullptr).first;
+        auto it = writes.try_emplace(std::move(ssKey), nullptr).first;
         if (it->second) {
-            memoryUsage -= ssKey.size() + it->second->memoryUsage;
+            memoryUsage -= keyMemoryUsage + it->second->memoryUsage;
         }
-        it->second = std::make_unique<ValueHolderImpl<V>>(v, valueMemoryUsage);
+        it->second = std::make_unique<ValueHolderImpl<ValueType>>(std::forward<V>(v), valueMemoryUsage);
 
-        memoryUsage += ssKey.size() + valueMemoryUsage;
+        memoryUsage += keyMemoryUsage + valueMemoryUsage;
     }
 
     template <typename K, typename V>
@@ -678,8 +727,11 @@ public:
         for (const auto &k : deletes) {
             commitTarget.Erase(k);
         }
-        for (auto &p : writes) {
-            p.second->Write(p.first, commitTarget);
+        // hand the keys and values over to the commit target instead of copying them, nodes are extracted as the
+        // keys of a map can't be moved from otherwise
+        while (!writes.empty()) {
+            auto node = writes.extract(writes.begin());
+            node.mapped()->Write(std::move(node.key()), commitTarget);
         }
         Clear();
     }
@@ -566,13 +566,35 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
 void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
 {
     assert(!replySent && req);
+    struct evbuffer* evb = evhttp_request_get_output_buffer(req);
+    assert(evb);
+    evbuffer_add(evb, strReply.data(), strReply.size());
+    SendReply(nStatus);
+}
+
+void HTTPRequest::WriteReply(int nStatus, std::string&& strReply)
+{
+    assert(!replySent && req);
+    if (strReply.empty()) {
+        SendReply(nStatus);
+        return;
+    }
+    // Large replies (e.g. verbose blocks) would otherwise be held in memory twice until they are sent
+    auto* reply = new std::string(std::move(strReply));
+    struct evbuffer* evb = evhttp_request_get_output_buffer(req);
+    assert(evb);
+    evbuffer_add_reference(evb, reply->data(), reply->size(), [](const void*, size_t, void* arg) {
+        delete static_cast<std::string*>(arg);
+    }, reply);
+    SendReply(nStatus);
+}
+
+void HTTPRequest::SendReply(int nStatus)
+{
     if (ShutdownRequested()) {
         WriteHeader("Connection", "close");
     }
     // Send event to main http thread to send reply message
-    struct evbuffer* evb = evhttp_request_get_output_buffer(req);
-    assert(evb);
-    evbuffer_add(evb, strReply.data(), strReply.size());
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
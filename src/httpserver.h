@@ -113,6 +113,11 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+    /** Same as above, but hands the reply buffer over to libevent instead of copying it. */
+    void WriteReply(int nStatus, std::string&& strReply);
+
+private:
+    void SendReply(int nStatus);
 };
 
 /** Event handler closure.
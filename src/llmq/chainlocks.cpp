@@ -15,9 +15,11 @@
 #include <node/ui_interface.h>
 #include <scheduler.h>
 #include <spork.h>
+#include <statsd_client.h>
 #include <txmempool.h>
 #include <util/thread.h>
 #include <util/time.h>
+#include <util/tracespan.h>
 #include <validation.h>
 #include <validationinterface.h>
 
@@ -106,6 +108,7 @@ PeerMsgRet CChainLocksHandler::ProcessMessage(const CNode& pfrom, const std::str
 
 PeerMsgRet CChainLocksHandler::ProcessNewChainLock(const NodeId from, const llmq::CChainLockSig& clsig, const uint256& hash)
 {
+    TRACE_SPAN("LLMQ.ProcessChainLock");
     CheckActiveState();
 
     CInv clsigInv(MSG_CLSIG, hash);
@@ -154,6 +157,14 @@ PeerMsgRet CChainLocksHandler::ProcessNewChainLock(const NodeId from, const llmq
 
             bestChainLockWithKnownBlock = bestChainLock;
             bestChainLockBlockIndex = pindex;
+
+            if (auto it = blockHeaderSeenTime.find(clsig.getBlockHash()); it != blockHeaderSeenTime.end()) {
+                const int64_t latency = GetTimeMillis() - it->second;
+                statsClient.timing("chainlocks_latency_ms", latency, 1.0f);
+                LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- block %s got chainlocked %dms after its header arrived\n",
+                         __func__, clsig.getBlockHash().ToString(), latency);
+                blockHeaderSeenTime.erase(it);
+            }
         }
         // else if (pindex == nullptr)
         // Note: make sure to still relay clsig further.
@@ -183,6 +194,10 @@ void CChainLocksHandler::AcceptedBlockHeader(gsl::not_null<const CBlockIndex*> p
 {
     LOCK(cs);
 
+    if (m_mn_sync.IsBlockchainSynced()) {
+        blockHeaderSeenTime.emplace(pindexNew->GetBlockHash(), GetTimeMillis());
+    }
+
     if (pindexNew->GetBlockHash() == bestChainLock.getBlockHash()) {
         LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- block header %s came in late, updating and enforcing\n", __func__, pindexNew->GetBlockHash().ToString());
 
@@ -207,12 +222,14 @@ void CChainLocksHandler::UpdatedBlockTip()
     // never locked and TrySignChainTip is not called twice in parallel. Also avoids recursive calls due to
     // EnforceBestChainLock switching chains.
     // atomic[If tryLockChainTipScheduled is false, do (set it to true] and schedule signing).
+    // The flag is reset before the job runs, so a tip arriving while we're signing schedules another run right away
+    // instead of waiting for the next periodic retry. The scheduler thread still runs jobs one at a time.
     if (bool expected = false; tryLockChainTipScheduled.compare_exchange_strong(expected, true)) {
         scheduler->scheduleFromNow([&]() {
+            tryLockChainTipScheduled = false;
             CheckActiveState();
             EnforceBestChainLock();
             TrySignChainTip();
-            tryLockChainTipScheduled = false;
         }, std::chrono::seconds{0});
     }
 }
@@ -314,7 +331,7 @@ void CChainLocksHandler::TrySignChainTip()
             for (const auto& txid : *txids) {
                 int64_t txAge = 0;
                 {
-                    LOCK(cs);
+                    LOCK(cs_tx_first_seen);
                     auto it = txFirstSeenTime.find(txid);
                     if (it != txFirstSeenTime.end()) {
                         txAge = GetTime<std::chrono::seconds>().count() - it->second;
@@ -355,7 +372,7 @@ void CChainLocksHandler::TransactionAddedToMempool(const CTransactionRef& tx, in
         return;
     }
 
-    LOCK(cs);
+    LOCK(cs_tx_first_seen);
     txFirstSeenTime.emplace(tx->GetHash(), nAcceptTime);
 }
 
@@ -381,6 +398,7 @@ void CChainLocksHandler::BlockConnected(const std::shared_ptr<const CBlock>& pbl
 
     int64_t curTime = GetTime<std::chrono::seconds>().count();
 
+    LOCK(cs_tx_first_seen);
     for (const auto& tx : pblock->vtx) {
         if (tx->IsCoinBase() || tx->vin.empty()) {
             continue;
@@ -438,7 +456,7 @@ CChainLocksHandler::BlockTxs::mapped_type CChainLocksHandler::GetBlockTxs(const
             blockTime = block.nTime;
         }
 
-        LOCK(cs);
+        LOCK2(cs, cs_tx_first_seen);
         blockTxs.emplace(blockHash, ret);
         for (const auto& txid : *ret) {
             txFirstSeenTime.emplace(txid, blockTime);
@@ -451,7 +469,7 @@ bool CChainLocksHandler::IsTxSafeForMining(const uint256& txid) const
 {
     int64_t txAge = 0;
     {
-        LOCK(cs);
+        LOCK(cs_tx_first_seen);
         auto it = txFirstSeenTime.find(txid);
         if (it != txFirstSeenTime.end()) {
             txAge = GetTime<std::chrono::seconds>().count() - it->second;
@@ -624,6 +642,7 @@ void CChainLocksHandler::Cleanup()
     // need mempool.cs due to GetTransaction calls
     LOCK2(cs_main, mempool.cs);
     LOCK(cs);
+    LOCK(cs_tx_first_seen);
 
     for (auto it = seenChainLocks.begin(); it != seenChainLocks.end(); ) {
         if (GetTimeMillis() - it->second >= CLEANUP_SEEN_TIMEOUT) {
@@ -632,6 +651,13 @@ void CChainLocksHandler::Cleanup()
             ++it;
         }
     }
+    for (auto it = blockHeaderSeenTime.begin(); it != blockHeaderSeenTime.end(); ) {
+        if (GetTimeMillis() - it->second >= CLEANUP_SEEN_TIMEOUT) {
+            it = blockHeaderSeenTime.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
     for (auto it = blockTxs.begin(); it != blockTxs.end(); ) {
         const auto* pindex = m_chainstate.m_blockman.LookupBlockIndex(it->first);
@@ -78,10 +78,16 @@ private:
     };
     using BlockTxs = std::unordered_map<uint256, std::shared_ptr<std::unordered_set<uint256, StaticSaltedHasher>>, BlockHasher>;
     BlockTxs blockTxs GUARDED_BY(cs);
-    std::unordered_map<uint256, int64_t, StaticSaltedHasher> txFirstSeenTime GUARDED_BY(cs);
+
+    // Updated for every mempool tx, so it's kept out of cs. Lock order is cs -> cs_tx_first_seen
+    mutable Mutex cs_tx_first_seen;
+    std::unordered_map<uint256, int64_t, StaticSaltedHasher> txFirstSeenTime GUARDED_BY(cs_tx_first_seen);
 
     std::map<uint256, int64_t> seenChainLocks GUARDED_BY(cs);
 
+    // Time at which we first saw the header of recent blocks, used to measure chainlock latency
+    std::unordered_map<uint256, int64_t, StaticSaltedHasher> blockHeaderSeenTime GUARDED_BY(cs);
+
     std::atomic<int64_t> lastCleanupTime{0};
 
 public:
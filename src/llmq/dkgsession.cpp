@@ -74,6 +74,15 @@ CDKGMember::CDKGMember(const CDeterministicMNCPtr& _dmn, size_t _idx) :
 
 }
 
+CDKGSession::~CDKGSession()
+{
+    // the BLS worker operates on the in-flight batch, don't free it before it's done
+    LOCK(cs_pending);
+    if (inFlightContributionVerification) {
+        inFlightContributionVerification->result.wait();
+    }
+}
+
 bool CDKGSession::Init(gsl::not_null<const CBlockIndex*> _pQuorumBaseBlockIndex, Span<CDeterministicMNCPtr> mns, const uint256& _myProTxHash, int _quorumIndex)
 {
     m_quorum_base_block_index = _pQuorumBaseBlockIndex;
@@ -243,12 +252,6 @@ bool CDKGSession::PreVerifyMessage(const CDKGContribution& qc, bool& retBan) con
         return false;
     }
 
-    if (!CBLSWorker::VerifyVerificationVector(*qc.vvec)) {
-        logger.Batch("invalid verification vector");
-        retBan = true;
-        return false;
-    }
-
     if (member->contributions.size() >= 2) {
         // don't do any further processing if we got more than 1 valid contributions already
         // this is a DoS protection against members sending multiple contributions with valid signatures to us
@@ -257,6 +260,12 @@ bool CDKGSession::PreVerifyMessage(const CDKGContribution& qc, bool& retBan) con
         return false;
     }
 
+    if (!CBLSWorker::VerifyVerificationVector(*qc.vvec)) {
+        logger.Batch("invalid verification vector");
+        retBan = true;
+        return false;
+    }
+
     return true;
 }
 
@@ -346,7 +355,8 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
     }
 
     if (verifyPending) {
-        VerifyPendingContributions();
+        // don't wait for the result, so that we can decrypt further contributions while the batch is verified
+        VerifyPendingContributions(/*wait=*/false);
     }
 }
 
@@ -355,45 +365,69 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
 // The resulting aggregated vvec is then used to recover a public key share
 // The public key share must match the public key belonging to the aggregated secret key contributions
 // See CBLSWorker::VerifyContributionShares for more details.
-void CDKGSession::VerifyPendingContributions()
+// Verification happens on the BLS worker. Unless wait is set, this returns as soon as the batch is handed over and
+// the result is collected when the next batch is started (or when verification is forced by VerifyAndComplain).
+void CDKGSession::VerifyPendingContributions(bool wait)
 {
     AssertLockHeld(cs_pending);
 
-    CDKGLogger logger(*this, __func__);
-
-    cxxtimer::Timer t1(true);
+    // keep at most one batch in flight so that results are processed in order
+    FinishContributionVerification();
 
     std::vector<size_t> pend = std::move(pendingContributionVerifications);
     if (pend.empty()) {
         return;
     }
 
-    std::vector<size_t> memberIndexes;
-    std::vector<BLSVerificationVectorPtr> vvecs;
-    std::vector<CBLSSecretKey> skContributions;
+    auto batch = std::make_unique<ContributionVerificationBatch>();
 
     for (const auto& idx : pend) {
         const auto& m = members[idx];
         if (m->bad || m->weComplain) {
             continue;
         }
-        memberIndexes.emplace_back(idx);
-        vvecs.emplace_back(receivedVvecs[idx]);
-        skContributions.emplace_back(receivedSkContributions[idx]);
+        batch->memberIndexes.emplace_back(idx);
+        batch->vvecs.emplace_back(receivedVvecs[idx]);
+        batch->skContributions.emplace_back(receivedSkContributions[idx]);
         // Write here to definitely store one contribution for each member no matter if
         // our share is valid or not, could be that others are still correct
         dkgManager.WriteEncryptedContributions(params.type, m_quorum_base_block_index, m->dmn->proTxHash, *vecEncryptedContributions[idx]);
     }
 
-    auto result = blsWorker.VerifyContributionShares(myId, vvecs, skContributions);
-    if (result.size() != memberIndexes.size()) {
-        logger.Batch("VerifyContributionShares returned result of size %d but size %d was expected, something is wrong", result.size(), memberIndexes.size());
+    if (batch->memberIndexes.empty()) {
+        return;
+    }
+
+    batch->result = blsWorker.AsyncVerifyContributionShares(myId, batch->vvecs, batch->skContributions, true, true);
+    inFlightContributionVerification = std::move(batch);
+
+    if (wait) {
+        FinishContributionVerification();
+    }
+}
+
+void CDKGSession::FinishContributionVerification()
+{
+    AssertLockHeld(cs_pending);
+
+    if (!inFlightContributionVerification) {
+        return;
+    }
+
+    CDKGLogger logger(*this, __func__);
+
+    cxxtimer::Timer t1(true);
+
+    const auto batch = std::move(inFlightContributionVerification);
+    const auto result = batch->result.get();
+    if (result.size() != batch->memberIndexes.size()) {
+        logger.Batch("VerifyContributionShares returned result of size %d but size %d was expected, something is wrong", result.size(), batch->memberIndexes.size());
         return;
     }
 
-    for (const auto i : irange::range(memberIndexes.size())) {
+    for (const auto i : irange::range(batch->memberIndexes.size())) {
         if (!result[i]) {
-            const auto& m = members[memberIndexes[i]];
+            const auto& m = members[batch->memberIndexes[i]];
             logger.Batch("invalid contribution from %s. will complain later", m->dmn->proTxHash.ToString());
             m->weComplain = true;
             dkgDebugManager.UpdateLocalMemberStatus(params.type, quorumIndex, m->idx, [&](CDKGDebugMemberStatus& status) {
@@ -401,12 +435,12 @@ void CDKGSession::VerifyPendingContributions()
                 return true;
             });
         } else {
-            size_t memberIdx = memberIndexes[i];
-            dkgManager.WriteVerifiedSkContribution(params.type, m_quorum_base_block_index, members[memberIdx]->dmn->proTxHash, skContributions[i]);
+            size_t memberIdx = batch->memberIndexes[i];
+            dkgManager.WriteVerifiedSkContribution(params.type, m_quorum_base_block_index, members[memberIdx]->dmn->proTxHash, batch->skContributions[i]);
         }
     }
 
-    logger.Batch("verified %d pending contributions. time=%d", pend.size(), t1.count());
+    logger.Batch("verified %d pending contributions. waited=%d", batch->memberIndexes.size(), t1.count());
 }
 
 void CDKGSession::VerifyAndComplain(CDKGPendingMessages& pendingMessages)
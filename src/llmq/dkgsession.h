@@ -13,6 +13,7 @@
 #include <util/underlying.h>
 #include <sync.h>
 
+#include <future>
 #include <optional>
 
 class UniValue;
@@ -304,8 +305,17 @@ private:
     std::map<uint256, CDKGJustification> justifications GUARDED_BY(invCs);
     std::map<uint256, CDKGPrematureCommitment> prematureCommitments GUARDED_BY(invCs);
 
+    // A batch of contribution shares handed to the BLS worker. Owns the inputs, as the worker only keeps spans to them
+    struct ContributionVerificationBatch {
+        std::vector<size_t> memberIndexes;
+        std::vector<BLSVerificationVectorPtr> vvecs;
+        std::vector<CBLSSecretKey> skContributions;
+        std::future<std::vector<bool>> result;
+    };
+
     mutable RecursiveMutex cs_pending;
     std::vector<size_t> pendingContributionVerifications GUARDED_BY(cs_pending);
+    std::unique_ptr<ContributionVerificationBatch> inFlightContributionVerification GUARDED_BY(cs_pending);
 
     // filled by ReceivePrematureCommitment and used by FinalizeCommitments
     std::set<uint256> validCommitments GUARDED_BY(invCs);
@@ -313,6 +323,7 @@ private:
 public:
     CDKGSession(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager, CDKGDebugManager& _dkgDebugManager, CConnman& _connman) :
         params(_params), blsWorker(_blsWorker), cache(_blsWorker), dkgManager(_dkgManager), dkgDebugManager(_dkgDebugManager), connman(_connman) {}
+    ~CDKGSession();
 
     bool Init(gsl::not_null<const CBlockIndex*> pQuorumBaseBlockIndex, Span<CDeterministicMNCPtr> mns, const uint256& _myProTxHash, int _quorumIndex);
 
@@ -336,7 +347,7 @@ public:
     void SendContributions(CDKGPendingMessages& pendingMessages);
     bool PreVerifyMessage(const CDKGContribution& qc, bool& retBan) const;
     void ReceiveMessage(const CDKGContribution& qc, bool& retBan);
-    void VerifyPendingContributions() EXCLUSIVE_LOCKS_REQUIRED(cs_pending);
+    void VerifyPendingContributions(bool wait = true) EXCLUSIVE_LOCKS_REQUIRED(cs_pending);
 
     // Phase 2: complaint
     void VerifyAndComplain(CDKGPendingMessages& pendingMessages);
@@ -370,6 +381,7 @@ public:
 
 private:
     [[nodiscard]] bool ShouldSimulateError(DKGError::type type) const;
+    void FinishContributionVerification() EXCLUSIVE_LOCKS_REQUIRED(cs_pending);
 };
 
 void SetSimulatedDKGErrorRate(DKGError::type type, double rate);
@@ -17,10 +17,12 @@
 #include <masternode/sync.h>
 #include <net_processing.h>
 #include <spork.h>
+#include <statsd_client.h>
 #include <txmempool.h>
 #include <util/irange.h>
 #include <util/ranges.h>
 #include <util/thread.h>
+#include <util/tracespan.h>
 #include <validation.h>
 
 #include <cxxtimer.hpp>
@@ -181,6 +183,8 @@ std::unordered_map<uint256, CInstantSendLockPtr, StaticSaltedHasher> CInstantSen
     }
     best_confirmed_height = nUntilHeight;
 
+    cxxtimer::Timer timer(true);
+
     auto it = std::unique_ptr<CDBIterator>(db->NewIterator());
 
     auto firstKey = BuildInversedISLockKey(DB_MINED_BY_HEIGHT_AND_HASH, nUntilHeight, uint256());
@@ -216,6 +220,10 @@ std::unordered_map<uint256, CInstantSendLockPtr, StaticSaltedHasher> CInstantSen
 
     db->WriteBatch(batch);
 
+    timer.stop();
+    statsClient.timing("instantsend_db_remove_confirmed_ms", timer.count(), 1.0f);
+    LogPrint(BCLog::INSTANTSEND, "CInstantSendDb::%s -- removed %d islocks until height %d in %dms\n", __func__, ret.size(), nUntilHeight, timer.count());
+
     return ret;
 }
 
@@ -226,6 +234,8 @@ void CInstantSendDb::RemoveArchivedInstantSendLocks(int nUntilHeight)
         return;
     }
 
+    cxxtimer::Timer timer(true);
+
     auto it = std::unique_ptr<CDBIterator>(db->NewIterator());
 
     auto firstKey = BuildInversedISLockKey(DB_ARCHIVED_BY_HEIGHT_AND_HASH, nUntilHeight, uint256());
@@ -251,6 +261,9 @@ void CInstantSendDb::RemoveArchivedInstantSendLocks(int nUntilHeight)
     }
 
     db->WriteBatch(batch);
+
+    timer.stop();
+    statsClient.timing("instantsend_db_remove_archived_ms", timer.count(), 1.0f);
 }
 
 void CInstantSendDb::WriteBlockInstantSendLocks(const gsl::not_null<std::shared_ptr<const CBlock>>& pblock,
@@ -859,6 +872,8 @@ bool CInstantSendManager::ProcessPendingInstantSendLocks()
         return false;
     }
 
+    TRACE_SPAN("LLMQ.ProcessInstantSendLocks");
+
     //TODO Investigate if leaving this is ok
     auto llmqType = Params().GetConsensus().llmqTypeDIP0024InstantSend;
     const auto& llmq_params_opt = Params().GetLLMQ(llmqType);
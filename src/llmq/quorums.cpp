@@ -32,6 +32,7 @@ namespace llmq
 
 static const std::string DB_QUORUM_SK_SHARE = "q_Qsk";
 static const std::string DB_QUORUM_QUORUM_VVEC = "q_Qqvvec";
+static const std::string DB_QUORUM_PK_SHARES = "q_Qpks";
 
 std::unique_ptr<CQuorumManager> quorumManager;
 
@@ -205,6 +206,57 @@ bool CQuorum::ReadContributions(CEvoDB& evoDb)
     return true;
 }
 
+void CQuorum::WritePubKeyShares(CEvoDB& evoDb) const
+{
+    if (!HasVerificationVector()) {
+        return;
+    }
+
+    CDataStream s(SER_DISK, CLIENT_VERSION);
+    // The stored shares are only valid for the verification vector committed to on chain
+    s << qc->quorumVvecHash;
+    WriteCompactSize(s, members.size());
+    for (const auto i : irange::range(members.size())) {
+        CBLSPublicKey pubKeyShare = GetPubKeyShare(i);
+        s << CBLSPublicKeyVersionWrapper(pubKeyShare, false);
+    }
+    evoDb.GetRawDB().Write(std::make_pair(DB_QUORUM_PK_SHARES, MakeQuorumKey(*this)), s);
+}
+
+bool CQuorum::ReadPubKeyShares(CEvoDB& evoDb) const
+{
+    CDataStream s(SER_DISK, CLIENT_VERSION);
+    if (!evoDb.GetRawDB().ReadDataStream(std::make_pair(DB_QUORUM_PK_SHARES, MakeQuorumKey(*this)), s)) {
+        return false;
+    }
+
+    try {
+        uint256 vvecHash;
+        s >> vvecHash;
+        if (vvecHash != qc->quorumVvecHash || ReadCompactSize(s) != members.size()) {
+            return false;
+        }
+
+        std::vector<CBLSPublicKey> pubKeyShares(members.size());
+        for (auto& pubKeyShare : pubKeyShares) {
+            s >> CBLSPublicKeyVersionWrapper(pubKeyShare, false);
+        }
+        for (const auto i : irange::range(members.size())) {
+            if (qc->validMembers[i]) {
+                if (!pubKeyShares[i].IsValid()) {
+                    return false;
+                }
+                blsCache.SetPubKeyShare(members[i]->proTxHash, pubKeyShares[i]);
+            }
+        }
+    } catch (const std::exception& e) {
+        LogPrint(BCLog::LLMQ, "CQuorum::%s -- failed to read public key shares for quorum %s: %s\n", __func__, qc->quorumHash.ToString(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
 CQuorumManager::CQuorumManager(CBLSWorker& _blsWorker, CChainState& chainstate, CConnman& _connman, CDKGSessionManager& _dkgManager,
                                CEvoDB& _evoDb, CQuorumBlockProcessor& _quorumBlockProcessor, const std::unique_ptr<CMasternodeSync>& mn_sync) :
     blsWorker(_blsWorker),
@@ -306,6 +358,10 @@ void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitial
         }
     }
 
+    if (!m_cache_warmup_started.exchange(true)) {
+        StartCacheWarmupThread(pindexNew);
+    }
+
     TriggerQuorumDataRecoveryThreads(pindexNew);
     StartCleanupOldQuorumDataThread(pindexNew);
 }
@@ -395,8 +451,10 @@ CQuorumPtr CQuorumManager::BuildQuorumFromCommitment(const Consensus::LLMQType l
     quorum->Init(std::move(qc), pQuorumBaseBlockIndex, minedBlockHash, members);
 
     bool hasValidVvec = false;
+    bool hasPubKeyShares = false;
     if (quorum->ReadContributions(m_evoDb)) {
         hasValidVvec = true;
+        hasPubKeyShares = quorum->ReadPubKeyShares(m_evoDb);
     } else {
         if (BuildQuorumContributions(quorum->qc, quorum)) {
             quorum->WriteContributions(m_evoDb);
@@ -406,7 +464,7 @@ CQuorumPtr CQuorumManager::BuildQuorumFromCommitment(const Consensus::LLMQType l
         }
     }
 
-    if (hasValidVvec && populate_cache) {
+    if (hasValidVvec && populate_cache && !hasPubKeyShares) {
         // pre-populate caches in the background
         // recovering public key shares is quite expensive and would result in serious lags for the first few signing
         // sessions if the shares would be calculated on-demand
@@ -860,12 +918,14 @@ void CQuorumManager::StartCachePopulatorThread(const CQuorumCPtr pQuorum) const
     workerPool.push([pQuorum, t, this](int threadId) {
         for (const auto i : irange::range(pQuorum->members.size())) {
             if (quorumThreadInterrupt) {
-                break;
+                return;
             }
             if (pQuorum->qc->validMembers[i]) {
                 pQuorum->GetPubKeyShare(i);
             }
         }
+        // keep them, so that we don't have to build them again after a restart
+        pQuorum->WritePubKeyShares(m_evoDb);
         LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- type=%d height=%d hash=%s done. time=%d\n",
                 ToUnderlying(pQuorum->params.type),
                 pQuorum->m_quorum_base_block_index->nHeight,
@@ -874,6 +934,24 @@ void CQuorumManager::StartCachePopulatorThread(const CQuorumCPtr pQuorum) const
     });
 }
 
+void CQuorumManager::StartCacheWarmupThread(const CBlockIndex* pIndex) const
+{
+    // Build the active quorums right after startup instead of on the first islock/clsig that needs them. Public key
+    // shares are loaded from disk if they were stored before, otherwise the cache populator builds them.
+    workerPool.push([pIndex, this](int threadId) {
+        cxxtimer::Timer t(true);
+        size_t nQuorums{0};
+        for (const auto& params : Params().GetConsensus().llmqs) {
+            if (quorumThreadInterrupt) {
+                return;
+            }
+            nQuorums += ScanQuorums(params.type, pIndex, params.signingActiveQuorumCount).size();
+        }
+        LogPrint(BCLog::LLMQ, "CQuorumManager::StartCacheWarmupThread -- loaded %d quorums at height %d. time=%d\n",
+                 nQuorums, pIndex->nHeight, t.count());
+    });
+}
+
 void CQuorumManager::StartQuorumDataRecoveryThread(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex, uint16_t nDataMaskIn) const
 {
     if (pQuorum->fQuorumDataRecoveryThreadRunning) {
@@ -997,7 +1075,7 @@ void CQuorumManager::StartQuorumDataRecoveryThread(const CQuorumCPtr pQuorum, co
 
 static void DataCleanupHelper(CDBWrapper& db, std::set<uint256> skip_list, bool compact = false)
 {
-    const auto prefixes = {DB_QUORUM_QUORUM_VVEC, DB_QUORUM_SK_SHARE};
+    const auto prefixes = {DB_QUORUM_QUORUM_VVEC, DB_QUORUM_SK_SHARE, DB_QUORUM_PK_SHARES};
 
     CDBBatch batch(db);
     std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
@@ -1097,28 +1175,26 @@ void CQuorumManager::StartCleanupOldQuorumDataThread(const CBlockIndex* pIndex)
     });
 }
 
-CQuorumCPtr SelectQuorumForSigning(const Consensus::LLMQParams& llmq_params, const CQuorumManager& quorum_manager, const uint256& selectionHash, int signHeight, int signOffset)
+static const CBlockIndex* GetSigningStartBlock(int signHeight, int signOffset)
 {
-    size_t poolSize = llmq_params.signingActiveQuorumCount;
+    LOCK(cs_main);
+    if (signHeight == -1) {
+        signHeight = ::ChainActive().Height();
+    }
+    int startBlockHeight = signHeight - signOffset;
+    if (startBlockHeight > ::ChainActive().Height() || startBlockHeight < 0) {
+        return nullptr;
+    }
+    return ::ChainActive()[startBlockHeight];
+}
 
-    CBlockIndex* pindexStart;
-    {
-        LOCK(cs_main);
-        if (signHeight == -1) {
-            signHeight = ::ChainActive().Height();
-        }
-        int startBlockHeight = signHeight - signOffset;
-        if (startBlockHeight > ::ChainActive().Height() || startBlockHeight < 0) {
-            return {};
-        }
-        pindexStart = ::ChainActive()[startBlockHeight];
+CQuorumCPtr SelectQuorumFromScan(const Consensus::LLMQParams& llmq_params, const std::vector<CQuorumCPtr>& quorums, bool fRotation, const uint256& selectionHash)
+{
+    if (quorums.empty()) {
+        return nullptr;
     }
 
-    if (IsQuorumRotationEnabled(llmq_params, pindexStart)) {
-        auto quorums = quorum_manager.ScanQuorums(llmq_params.type, pindexStart, poolSize);
-        if (quorums.empty()) {
-            return nullptr;
-        }
+    if (fRotation) {
         //log2 int
         int n = std::log2(llmq_params.signingActiveQuorumCount);
         //Extract last 64 bits of selectionHash
@@ -1139,11 +1215,6 @@ CQuorumCPtr SelectQuorumForSigning(const Consensus::LLMQParams& llmq_params, con
         }
         return *itQuorum;
     } else {
-        auto quorums = quorum_manager.ScanQuorums(llmq_params.type, pindexStart, poolSize);
-        if (quorums.empty()) {
-            return nullptr;
-        }
-
         std::vector<std::pair<uint256, size_t>> scores;
         scores.reserve(quorums.size());
         for (const auto i : irange::range(quorums.size())) {
@@ -1158,6 +1229,17 @@ CQuorumCPtr SelectQuorumForSigning(const Consensus::LLMQParams& llmq_params, con
     }
 }
 
+CQuorumCPtr SelectQuorumForSigning(const Consensus::LLMQParams& llmq_params, const CQuorumManager& quorum_manager, const uint256& selectionHash, int signHeight, int signOffset)
+{
+    const CBlockIndex* pindexStart = GetSigningStartBlock(signHeight, signOffset);
+    if (pindexStart == nullptr) {
+        return {};
+    }
+
+    auto quorums = quorum_manager.ScanQuorums(llmq_params.type, pindexStart, llmq_params.signingActiveQuorumCount);
+    return SelectQuorumFromScan(llmq_params, quorums, IsQuorumRotationEnabled(llmq_params, pindexStart), selectionHash);
+}
+
 bool VerifyRecoveredSig(Consensus::LLMQType llmqType, const CQuorumManager& quorum_manager, int signedAtHeight, const uint256& id, const uint256& msgHash, const CBLSSignature& sig, const int signOffset)
 {
     const auto& llmq_params_opt = Params().GetLLMQ(llmqType);
@@ -203,6 +203,9 @@ public:
 private:
     void WriteContributions(CEvoDB& evoDb) const;
     bool ReadContributions(CEvoDB& evoDb);
+    // Public key shares of all valid members, stored once the cache populator has built them
+    void WritePubKeyShares(CEvoDB& evoDb) const;
+    bool ReadPubKeyShares(CEvoDB& evoDb) const;
 };
 
 /**
@@ -231,6 +234,7 @@ private:
 
     mutable ctpl::thread_pool workerPool;
     mutable CThreadInterrupt quorumThreadInterrupt;
+    mutable std::atomic<bool> m_cache_warmup_started{false};
 
 public:
     CQuorumManager(CBLSWorker& _blsWorker, CChainState& chainstate, CConnman& _connman, CDKGSessionManager& _dkgManager,
@@ -271,6 +275,7 @@ private:
     size_t GetQuorumRecoveryStartOffset(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex) const;
 
     void StartCachePopulatorThread(const CQuorumCPtr pQuorum) const;
+    void StartCacheWarmupThread(const CBlockIndex* pIndex) const;
     void StartQuorumDataRecoveryThread(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex, uint16_t nDataMask) const;
 
     void StartCleanupOldQuorumDataThread(const CBlockIndex* pIndex) const;
@@ -284,6 +289,8 @@ extern std::unique_ptr<CQuorumManager> quorumManager;
 static constexpr int SIGN_HEIGHT_OFFSET{8};
 
 CQuorumCPtr SelectQuorumForSigning(const Consensus::LLMQParams& llmq_params, const CQuorumManager& quorum_manager, const uint256& selectionHash, int signHeight = -1 /*chain tip*/, int signOffset = SIGN_HEIGHT_OFFSET);
+// Selects the quorum for selectionHash out of the active quorums returned by ScanQuorums for the signing start block
+CQuorumCPtr SelectQuorumFromScan(const Consensus::LLMQParams& llmq_params, const std::vector<CQuorumCPtr>& quorums, bool fRotation, const uint256& selectionHash);
 
 // Verifies a recovered sig that was signed while the chain tip was at signedAtTip
 bool VerifyRecoveredSig(Consensus::LLMQType llmqType, const CQuorumManager& quorum_manager, int signedAtHeight, const uint256& id, const uint256& msgHash, const CBLSSignature& sig, int signOffset = SIGN_HEIGHT_OFFSET);
@@ -18,10 +18,12 @@
 #include <net_processing.h>
 #include <netmessagemaker.h>
 #include <scheduler.h>
+#include <statsd_client.h>
 #include <streams.h>
 #include <util/irange.h>
 #include <util/thread.h>
 #include <util/time.h>
+#include <util/tracespan.h>
 #include <util/underlying.h>
 #include <validation.h>
 
@@ -418,16 +420,18 @@ void CRecoveredSigsDb::TruncateRecoveredSig(Consensus::LLMQType llmqType, const
     db->WriteBatch(batch);
 }
 
-void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
+bool CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge, size_t maxEntries)
 {
+    cxxtimer::Timer timer(true);
+
     std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
 
     auto start = std::make_tuple(std::string("rs_t"), (uint32_t)0, (Consensus::LLMQType)0, uint256());
     uint32_t endTime = (uint32_t)(GetTime<std::chrono::seconds>().count() - maxAge);
     pcursor->Seek(start);
 
-    std::vector<std::pair<Consensus::LLMQType, uint256>> toDelete;
-    std::vector<decltype(start)> toDelete2;
+    std::vector<decltype(start)> toDelete;
+    bool more{false};
 
     while (pcursor->Valid()) {
         decltype(start) k;
@@ -438,38 +442,46 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
         if (be32toh(std::get<1>(k)) >= endTime) {
             break;
         }
+        if (toDelete.size() >= maxEntries) {
+            more = true;
+            break;
+        }
 
-        toDelete.emplace_back(std::get<2>(k), std::get<3>(k));
-        toDelete2.emplace_back(k);
+        toDelete.emplace_back(k);
 
         pcursor->Next();
     }
     pcursor.reset();
 
     if (toDelete.empty()) {
-        return;
+        return false;
     }
 
+    // Erase the time key together with the entry it points to, so that an interrupted
+    // cleanup never leaves entries behind which can't be found anymore
     CDBBatch batch(*db);
     {
         LOCK(cs);
-        for (const auto& e : toDelete) {
-            RemoveRecoveredSig(batch, e.first, e.second, true, false);
+        for (const auto& k : toDelete) {
+            RemoveRecoveredSig(batch, std::get<2>(k), std::get<3>(k), true, false);
+            batch.Erase(k);
 
-            if (batch.SizeEstimate() >= (1 << 24)) {
+            if (batch.SizeEstimate() >= MAX_CLEANUP_BATCH_SIZE) {
                 db->WriteBatch(batch);
                 batch.Clear();
             }
         }
     }
 
-    for (const auto& e : toDelete2) {
-        batch.Erase(e);
-    }
-
     db->WriteBatch(batch);
 
-    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, toDelete.size());
+    timer.stop();
+    statsClient.timing("llmq_recsigs_cleanup_ms", timer.count(), 1.0f);
+    statsClient.count("llmq_recsigs_cleanup_entries", toDelete.size(), 1.0f);
+
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- deleted %d entries in %dms, more=%d\n", __func__, toDelete.size(), timer.count(), more);
+
+    return more;
 }
 
 bool CRecoveredSigsDb::HasVotedOnId(Consensus::LLMQType llmqType, const uint256& id) const
@@ -496,8 +508,10 @@ void CRecoveredSigsDb::WriteVoteForId(Consensus::LLMQType llmqType, const uint25
     db->WriteBatch(batch);
 }
 
-void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
+bool CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge, size_t maxEntries)
 {
+    cxxtimer::Timer timer(true);
+
     std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
 
     auto start = std::make_tuple(std::string("rs_vt"), (uint32_t)0, (Consensus::LLMQType)0, uint256());
@@ -506,6 +520,7 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 
     CDBBatch batch(*db);
     size_t cnt = 0;
+    bool more{false};
     while (pcursor->Valid()) {
         decltype(start) k;
 
@@ -515,6 +530,10 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
         if (be32toh(std::get<1>(k)) >= endTime) {
             break;
         }
+        if (cnt >= maxEntries) {
+            more = true;
+            break;
+        }
 
         Consensus::LLMQType llmqType = std::get<2>(k);
         const uint256& id = std::get<3>(k);
@@ -529,12 +548,18 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
     pcursor.reset();
 
     if (cnt == 0) {
-        return;
+        return false;
     }
 
     db->WriteBatch(batch);
 
-    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, cnt);
+    timer.stop();
+    statsClient.timing("llmq_votes_cleanup_ms", timer.count(), 1.0f);
+    statsClient.count("llmq_votes_cleanup_entries", cnt, 1.0f);
+
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- deleted %d entries in %dms, more=%d\n", __func__, cnt, timer.count(), more);
+
+    return more;
 }
 
 //////////////////
@@ -741,6 +766,8 @@ bool CSigningManager::ProcessPendingRecoveredSigs()
         return false;
     }
 
+    TRACE_SPAN("LLMQ.ProcessRecoveredSigs");
+
     // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
     // craftable by individual entities, making the rogue public key attack impossible
     CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, false);
@@ -874,10 +901,12 @@ void CSigningManager::Cleanup()
 
     int64_t maxAge = gArgs.GetArg("-maxrecsigsage", DEFAULT_MAX_RECOVERED_SIGS_AGE);
 
-    db.CleanupOldRecoveredSigs(maxAge);
-    db.CleanupOldVotes(maxAge);
+    // Expired entries are removed in bounded chunks so that a large backlog (e.g. after a restart)
+    // does not block the worker thread. If anything is left, run again on the next call.
+    bool more = db.CleanupOldRecoveredSigs(maxAge, MAX_CLEANUP_ENTRIES_PER_RUN);
+    more |= db.CleanupOldVotes(maxAge, MAX_CLEANUP_ENTRIES_PER_RUN);
 
-    lastCleanupTime = GetTimeMillis();
+    lastCleanupTime = more ? 0 : GetTimeMillis();
 }
 
 void CSigningManager::RegisterRecoveredSigsListener(CRecoveredSigsListener* l)
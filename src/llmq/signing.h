@@ -37,6 +37,10 @@ class CSigSharesManager;
 
 // Keep recovered signatures for a week. This is a "-maxrecsigsage" option default.
 static constexpr int64_t DEFAULT_MAX_RECOVERED_SIGS_AGE{60 * 60 * 24 * 7};
+// Upper bound of expired entries removed per CSigningManager::Cleanup() run
+static constexpr size_t MAX_CLEANUP_ENTRIES_PER_RUN{10000};
+// Flush cleanup batches early so a single LevelDB write never gets too large
+static constexpr size_t MAX_CLEANUP_BATCH_SIZE{1 << 20};
 
 class CSigBase
 {
@@ -131,14 +135,16 @@ public:
     void WriteRecoveredSig(const CRecoveredSig& recSig);
     void TruncateRecoveredSig(Consensus::LLMQType llmqType, const uint256& id);
 
-    void CleanupOldRecoveredSigs(int64_t maxAge);
+    /** Removes at most maxEntries expired recovered sigs, returns true if more expired entries are left */
+    bool CleanupOldRecoveredSigs(int64_t maxAge, size_t maxEntries);
 
     // votes are removed when the recovered sig is written to the db
     bool HasVotedOnId(Consensus::LLMQType llmqType, const uint256& id) const;
     bool GetVoteForId(Consensus::LLMQType llmqType, const uint256& id, uint256& msgHashRet) const;
     void WriteVoteForId(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash);
 
-    void CleanupOldVotes(int64_t maxAge);
+    /** Removes at most maxEntries expired votes, returns true if more expired entries are left */
+    bool CleanupOldVotes(int64_t maxAge, size_t maxEntries);
 
 private:
     void MigrateRecoveredSigs();
@@ -19,6 +19,7 @@
 #include <util/irange.h>
 #include <util/thread.h>
 #include <util/time.h>
+#include <util/tracespan.h>
 #include <util/underlying.h>
 
 #include <cxxtimer.hpp>
@@ -616,6 +617,8 @@ bool CSigSharesManager::ProcessPendingSigShares(const CConnman& connman)
         return false;
     }
 
+    TRACE_SPAN("LLMQ.ProcessSigShares");
+
     // It's ok to perform insecure batched verification here as we verify against the quorum public key shares,
     // which are not craftable by individual entities, making the rogue public key attack impossible
     CBLSBatchVerifier<NodeId, SigShareKey> batchVerifier(false, true);
@@ -24,8 +24,9 @@ BCLog::Logger& LogInstance()
  * access the logger. When the shutdown sequence is fully audited and tested,
  * explicit destruction of these objects can be implemented by changing this
  * from a raw pointer to a std::unique_ptr.
- * Since the ~Logger() destructor is never called, the Logger class and all
- * its subclasses must have implicitly-defined destructors.
+ * Since the ~Logger() destructor of this instance is never called, it must
+ * not be relied on to write out queued messages; Shutdown() stops the file
+ * writer instead.
  *
  * This method of initialization was originally introduced in
  * ee3374234c60aba2cc4c5cd5cac1c0aefc2d817c.
@@ -44,6 +45,7 @@ static int FileWriteStr(const std::string &str, FILE *fp)
 bool BCLog::Logger::StartLogging()
 {
     StdLockGuard scoped_lock(m_cs);
+    StdLockGuard write_lock(m_file_write_cs);
 
     assert(m_buffering);
     assert(m_fileout == nullptr);
@@ -77,12 +79,85 @@ bool BCLog::Logger::StartLogging()
     }
     if (m_print_to_console) fflush(stdout);
 
+    if (m_print_to_file) {
+        assert(!m_file_writer.joinable());
+        m_file_writer_running = true;
+        m_file_writer = std::thread(&BCLog::Logger::FileWriterThread, this);
+    }
+
     return true;
 }
 
+void BCLog::Logger::FileWriterThread()
+{
+    util::ThreadRename("logger");
+
+    std::unique_lock<std::mutex> lock(m_cs);
+    while (true) {
+        m_file_writer_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_cs) { return !m_file_queue.empty() || m_file_writer_stop; });
+        if (m_file_queue.empty()) {
+            // Everything queued so far is written, later messages are written synchronously
+            m_file_writer_running = false;
+            break;
+        }
+        std::string batch;
+        batch.swap(m_file_queue);
+        {
+            StdLockGuard write_lock(m_file_write_cs);
+            lock.unlock();
+            // m_fileout is only replaced or closed while holding m_file_write_cs
+            WriteToFile(batch);
+        }
+        lock.lock();
+    }
+}
+
+void BCLog::Logger::StopFileWriter()
+{
+    {
+        StdLockGuard scoped_lock(m_cs);
+        m_file_writer_stop = true;
+    }
+    m_file_writer_cv.notify_one();
+    if (m_file_writer.joinable()) m_file_writer.join();
+
+    StdLockGuard scoped_lock(m_cs);
+    m_file_writer_stop = false;
+}
+
+BCLog::Logger::~Logger()
+{
+    StopFileWriter();
+    StdLockGuard write_lock(m_file_write_cs);
+    if (m_fileout != nullptr) fclose(m_fileout);
+}
+
+void BCLog::Logger::FlushFileQueue(bool try_lock)
+{
+    std::unique_lock<std::mutex> lock(m_cs, std::defer_lock);
+    std::unique_lock<std::mutex> write_lock(m_file_write_cs, std::defer_lock);
+    if (try_lock) {
+        if (!lock.try_lock() || !write_lock.try_lock()) return;
+    } else {
+        lock.lock();
+        write_lock.lock();
+    }
+    if (m_fileout != nullptr && !m_file_queue.empty()) {
+        // don't reopen the file from an abort or terminate handler
+        if (try_lock) {
+            FileWriteStr(m_file_queue, m_fileout);
+        } else {
+            WriteToFile(m_file_queue);
+        }
+        m_file_queue.clear();
+    }
+}
+
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopFileWriter();
     StdLockGuard scoped_lock(m_cs);
+    StdLockGuard write_lock(m_file_write_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
     m_fileout = nullptr;
@@ -297,20 +372,64 @@ void BCLog::Logger::LogPrintStr(const std::string& str)
         cb(str_prefixed);
     }
     if (m_print_to_file) {
+        if (m_file_writer_running && m_file_queue.size() < MAX_FILE_QUEUE_SIZE) {
+            m_file_queue += str_prefixed;
+            m_file_writer_cv.notify_one();
+            return;
+        }
+
+        // The writer is stopped or falling behind, write the backlog and this message from the calling thread
+        StdLockGuard write_lock(m_file_write_cs);
         assert(m_fileout != nullptr);
+        if (!m_file_queue.empty()) {
+            WriteToFile(m_file_queue);
+            m_file_queue.clear();
+        }
+        WriteToFile(str_prefixed);
+    }
+}
 
-        // reopen the log file, if requested
-        if (m_reopen_file) {
-            m_reopen_file = false;
-            FILE* new_fileout = fsbridge::fopen(m_file_path, "a");
-            if (new_fileout) {
-                setbuf(new_fileout, nullptr); // unbuffered
-                fclose(m_fileout);
-                m_fileout = new_fileout;
-            }
+void BCLog::Logger::WriteToFile(const std::string& str)
+{
+    // reopen the log file, if requested
+    if (m_reopen_file) {
+        m_reopen_file = false;
+        FILE* new_fileout = fsbridge::fopen(m_file_path, "a");
+        if (new_fileout) {
+            setbuf(new_fileout, nullptr); // unbuffered
+            fclose(m_fileout);
+            m_fileout = new_fileout;
         }
-        FileWriteStr(str_prefixed, m_fileout);
     }
+    FileWriteStr(str, m_fileout);
+}
+
+bool BCLog::Logger::AllowCallSite(const char* file, int line)
+{
+    if (!m_rate_limit) return true;
+
+    const auto now = std::chrono::steady_clock::now();
+    uint64_t suppressed{0};
+    {
+        StdLockGuard scoped_lock(m_rate_limit_cs);
+        auto it = m_call_sites.try_emplace(CallSite{file, line}, CallSiteState{now}).first;
+        CallSiteState& site = it->second;
+        if (now - site.window_start >= RATE_LIMIT_WINDOW) {
+            suppressed = site.suppressed;
+            site = CallSiteState{now};
+        }
+        if (site.logged >= RATE_LIMIT_MESSAGES) {
+            ++site.suppressed;
+            return false;
+        }
+        ++site.logged;
+    }
+
+    if (suppressed > 0) {
+        LogPrintStr(strprintf("Suppressed %d messages from %s:%d in the last %d seconds\n",
+                              suppressed, file, line, count_seconds(RATE_LIMIT_WINDOW)));
+    }
+    return true;
 }
 
 void BCLog::Logger::ShrinkDebugFile()
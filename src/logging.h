@@ -12,16 +12,21 @@
 #include <util/string.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 static const bool DEFAULT_LOGTIMEMICROS  = false;
 static const bool DEFAULT_LOGIPS         = false;
 static const bool DEFAULT_LOGTIMESTAMPS  = true;
 static const bool DEFAULT_LOGTHREADNAMES = false;
+static const bool DEFAULT_LOGRATELIMIT   = true;
 extern const char * const DEFAULT_DEBUGLOGFILE;
 
 extern bool fLogThreadNames;
@@ -84,15 +89,55 @@ namespace BCLog {
         ALL         = ~(uint64_t)0,
     };
 
+    //! Number of messages a single unconditional LogPrintf call site may write per window
+    static constexpr uint64_t RATE_LIMIT_MESSAGES{1000};
+    static constexpr std::chrono::seconds RATE_LIMIT_WINDOW{60};
+    //! Pending file output above which logging threads write to the file themselves
+    static constexpr size_t MAX_FILE_QUEUE_SIZE{16 << 20};
+
     class Logger
     {
     private:
         mutable StdMutex m_cs; // Can not use Mutex from sync.h because in debug mode it would cause a deadlock when a potential deadlock was detected
+        //! Serializes writes to m_fileout. Lock order: m_cs -> m_file_write_cs
+        StdMutex m_file_write_cs;
 
-        FILE* m_fileout GUARDED_BY(m_cs) = nullptr;
+        FILE* m_fileout GUARDED_BY(m_file_write_cs) = nullptr;
         std::list<std::string> m_msgs_before_open GUARDED_BY(m_cs);
         bool m_buffering GUARDED_BY(m_cs) = true; //!< Buffer messages before logging can be started.
 
+        /**
+         * File output is handed to a background writer thread, so logging
+         * threads do not block on the write syscall. The writer drains
+         * everything queued since its last write in a single batch.
+         */
+        std::string m_file_queue GUARDED_BY(m_cs);
+        bool m_file_writer_running GUARDED_BY(m_cs) = false;
+        bool m_file_writer_stop GUARDED_BY(m_cs) = false;
+        std::condition_variable m_file_writer_cv;
+        std::thread m_file_writer;
+
+        struct CallSiteState {
+            std::chrono::steady_clock::time_point window_start;
+            uint64_t logged{0};
+            uint64_t suppressed{0};
+        };
+        //! Source location of a LogPrintf call, as captured by the macro
+        struct CallSite {
+            const char* file;
+            int line;
+            bool operator==(const CallSite& other) const { return file == other.file && line == other.line; }
+        };
+        struct CallSiteHasher {
+            size_t operator()(const CallSite& site) const
+            {
+                return std::hash<const char*>{}(site.file) ^ (std::hash<int>{}(site.line) << 1);
+            }
+        };
+        StdMutex m_rate_limit_cs;
+        //! Rate limit state per LogPrintf call site. Bounded by the number of call sites in the binary.
+        std::unordered_map<CallSite, CallSiteState, CallSiteHasher> m_call_sites GUARDED_BY(m_rate_limit_cs);
+
         /**
          * m_started_new_line is a state variable that will suppress printing of
          * the timestamp when multiple calls are made that don't end in a
@@ -106,6 +151,9 @@ namespace BCLog {
         std::string LogTimestampStr(const std::string& str);
         std::string LogThreadNameStr(const std::string &str);
 
+        void FileWriterThread();
+        void WriteToFile(const std::string& str) EXCLUSIVE_LOCKS_REQUIRED(m_file_write_cs);
+
         /** Slots that connect to the print signal */
         std::list<std::function<void(const std::string&)>> m_print_callbacks /* GUARDED_BY(m_cs) */ {};
 
@@ -116,6 +164,7 @@ namespace BCLog {
         bool m_log_timestamps = DEFAULT_LOGTIMESTAMPS;
         bool m_log_time_micros = DEFAULT_LOGTIMEMICROS;
         bool m_log_threadnames = DEFAULT_LOGTHREADNAMES;
+        bool m_rate_limit = DEFAULT_LOGRATELIMIT;
 
         fs::path m_file_path;
         std::atomic<bool> m_reopen_file{false};
@@ -123,6 +172,13 @@ namespace BCLog {
         /** Send a string to the log output */
         void LogPrintStr(const std::string& str);
 
+        /**
+         * Returns whether the LogPrintf call site at file:line may log now.
+         * Logs how many messages were suppressed once a rate limited call
+         * site is allowed to log again.
+         */
+        bool AllowCallSite(const char* file, int line);
+
         /** Returns whether logs will be written to any output */
         bool Enabled() const
         {
@@ -145,8 +201,18 @@ namespace BCLog {
             m_print_callbacks.erase(it);
         }
 
+        ~Logger();
+
         /** Start logging (and flush all buffered messages) */
         bool StartLogging();
+        /** Write out all queued file output and stop the background writer. Later messages are written synchronously. */
+        void StopFileWriter();
+        /**
+         * Write out the queued file output from the calling thread, e.g. before the
+         * process aborts. With try_lock it gives up instead of waiting for a lock, so
+         * it can't deadlock when called from a thread which is logging already.
+         */
+        void FlushFileQueue(bool try_lock = false);
         /** Only for testing */
         void DisconnectTestLogger();
 
@@ -202,9 +268,9 @@ std::string SafeStringFormat(const std::string& fmt, const Args&... args)
 // peer can fill up a user's disk with debug.log entries.
 
 template <typename... Args>
-static inline void LogPrintf(const char* fmt, const Args&... args)
+static inline void LogPrintFormatInternal(const char* file, int line, bool rate_limit, const char* fmt, const Args&... args)
 {
-    if (LogInstance().Enabled()) {
+    if (LogInstance().Enabled() && (!rate_limit || LogInstance().AllowCallSite(file, line))) {
         std::string log_msg;
         try {
             log_msg = tfm::format(fmt, args...);
@@ -216,13 +282,22 @@ static inline void LogPrintf(const char* fmt, const Args&... args)
     }
 }
 
+// Unconditional logging is rate limited per source location, see BCLog::RATE_LIMIT_MESSAGES.
+#define LogPrintf(...) LogPrintFormatInternal(__FILE__, __LINE__, /* rate_limit= */ true, __VA_ARGS__)
+
+// Unconditional logging that is exempt from rate limiting. Only for progress
+// reporting that is expected to be frequent (e.g. UpdateTip during sync) and
+// for wrappers that forward many callers' messages through one LogPrintf.
+#define LogPrintfNoRateLimit(...) LogPrintFormatInternal(__FILE__, __LINE__, /* rate_limit= */ false, __VA_ARGS__)
+
 // Use a macro instead of a function for conditional logging to prevent
 // evaluating arguments when logging for the category is not enabled.
-#define LogPrint(category, ...)              \
-    do {                                     \
-        if (LogAcceptCategory((category))) { \
-            LogPrintf(__VA_ARGS__);          \
-        }                                    \
+// Categories are opted into explicitly and are not rate limited.
+#define LogPrint(category, ...)                                                                 \
+    do {                                                                                        \
+        if (LogAcceptCategory((category))) {                                                    \
+            LogPrintFormatInternal(__FILE__, __LINE__, /* rate_limit= */ false, __VA_ARGS__);   \
+        }                                                                                       \
     } while (0)
 
 #endif // BITCOIN_LOGGING_H
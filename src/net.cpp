@@ -44,6 +44,7 @@
 #include <string.h>
 #else
 #include <fcntl.h>
+#include <sys/uio.h>
 #endif
 
 #if HAVE_DECL_GETIFADDRS && HAVE_DECL_FREEIFADDRS
@@ -63,6 +64,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <unordered_map>
@@ -680,6 +682,7 @@ void CNode::copyStats(CNodeStats &stats, const std::vector<bool> &m_asmap)
         LOCK(cs_vSend);
         X(mapSendBytesPerMsgCmd);
         X(nSendBytes);
+        X(nSendCalls);
     }
     {
         LOCK(cs_vRecv);
@@ -885,26 +888,53 @@ size_t CConnman::SocketSendData(CNode *pnode) EXCLUSIVE_LOCKS_REQUIRED(pnode->cs
     size_t nSentSize = 0;
 
     while (it != pnode->vSendMsg.end()) {
-        const auto &data = *it;
-        assert(data.size() > pnode->nSendOffset);
+        assert(it->size() > pnode->nSendOffset);
         int nBytes = 0;
+        size_t nBytesToSend = 0;
         {
             LOCK(pnode->cs_hSocket);
             if (pnode->hSocket == INVALID_SOCKET)
                 break;
-            nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(data.data()) + pnode->nSendOffset, data.size() - pnode->nSendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+#ifdef WIN32
+            nBytesToSend = it->size() - pnode->nSendOffset;
+            nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(it->data()) + pnode->nSendOffset, nBytesToSend, MSG_NOSIGNAL | MSG_DONTWAIT);
+#else
+            // Hand the queued message headers and payloads to the kernel in a single call
+            std::array<struct iovec, MAX_SEND_IOVECS> iov;
+            size_t nIov = 0;
+            size_t nOffset = pnode->nSendOffset;
+            for (auto it_iov = it; it_iov != pnode->vSendMsg.end() && nIov < iov.size(); ++it_iov, ++nIov) {
+                iov[nIov].iov_base = const_cast<unsigned char*>(it_iov->data()) + nOffset;
+                iov[nIov].iov_len = it_iov->size() - nOffset;
+                nBytesToSend += iov[nIov].iov_len;
+                nOffset = 0;
+            }
+            struct msghdr msg{};
+            msg.msg_iov = iov.data();
+            msg.msg_iovlen = nIov;
+            nBytes = sendmsg(pnode->hSocket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+#endif
         }
         if (nBytes > 0) {
             pnode->nLastSend = GetSystemTimeInSeconds();
             pnode->nSendBytes += nBytes;
-            pnode->nSendOffset += nBytes;
+            pnode->nSendCalls++;
             nSentSize += nBytes;
-            if (pnode->nSendOffset == data.size()) {
+            // Drop the buffers which were sent completely
+            size_t nRemaining = nBytes;
+            while (nRemaining > 0) {
+                const size_t nLeft = it->size() - pnode->nSendOffset;
+                if (nRemaining < nLeft) {
+                    pnode->nSendOffset += nRemaining;
+                    break;
+                }
+                nRemaining -= nLeft;
                 pnode->nSendOffset = 0;
-                pnode->nSendSize -= data.size();
-                pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+                pnode->nSendSize -= it->size();
                 it++;
-            } else {
+            }
+            pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+            if ((size_t)nBytes < nBytesToSend) {
                 // could not send full message; stop sending more
                 pnode->fCanSendData = false;
                 break;
@@ -1534,14 +1564,17 @@ bool CConnman::InactivityCheck(const CNode& node) const
     return false;
 }
 
-bool CConnman::GenerateSelectSet(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set)
+bool CConnman::GenerateSelectSet(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set)
 {
     for (const ListenSocket& hListenSocket : vhListenSocket) {
-        recv_set.insert(hListenSocket.socket);
+        recv_set.push_back(hListenSocket.socket);
     }
 
     {
         LOCK(cs_vNodes);
+        recv_set.reserve(recv_set.size() + vNodes.size() + 1);
+        send_set.reserve(vNodes.size());
+        error_set.reserve(vNodes.size());
         for (CNode* pnode : vNodes)
         {
             bool select_recv = !pnode->fHasRecvData;
@@ -1551,12 +1584,12 @@ bool CConnman::GenerateSelectSet(std::set<SOCKET> &recv_set, std::set<SOCKET> &s
             if (pnode->hSocket == INVALID_SOCKET)
                 continue;
 
-            error_set.insert(pnode->hSocket);
+            error_set.push_back(pnode->hSocket);
             if (select_send) {
-                send_set.insert(pnode->hSocket);
+                send_set.push_back(pnode->hSocket);
             }
             if (select_recv) {
-                recv_set.insert(pnode->hSocket);
+                recv_set.push_back(pnode->hSocket);
             }
         }
     }
@@ -1567,14 +1600,14 @@ bool CConnman::GenerateSelectSet(std::set<SOCKET> &recv_set, std::set<SOCKET> &s
     // This is currently only implemented for POSIX compliant systems. This means that Windows will fall back to
     // timing out after 50ms and then trying to send. This is ok as we assume that heavy-load daemons are usually
     // run on Linux and friends.
-    recv_set.insert(wakeupPipe[0]);
+    recv_set.push_back(wakeupPipe[0]);
 #endif
 
     return !recv_set.empty() || !send_set.empty() || !error_set.empty();
 }
 
 #ifdef USE_KQUEUE
-void CConnman::SocketEventsKqueue(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll)
+void CConnman::SocketEventsKqueue(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll)
 {
     const size_t maxEvents = 64;
     struct kevent events[maxEvents];
@@ -1592,16 +1625,19 @@ void CConnman::SocketEventsKqueue(std::set<SOCKET> &recv_set, std::set<SOCKET> &
         for (int i = 0; i < n; i++) {
             auto& event = events[i];
             if ((event.flags & EV_ERROR) || (event.flags & EV_EOF)) {
-                error_set.insert((SOCKET)event.ident);
+                // the read and write filters of a socket may both report the error
+                if (std::find(error_set.begin(), error_set.end(), (SOCKET)event.ident) == error_set.end()) {
+                    error_set.push_back((SOCKET)event.ident);
+                }
                 continue;
             }
 
             if (event.filter == EVFILT_READ) {
-                recv_set.insert((SOCKET)event.ident);
+                recv_set.push_back((SOCKET)event.ident);
             }
 
             if (event.filter == EVFILT_WRITE) {
-                send_set.insert((SOCKET)event.ident);
+                send_set.push_back((SOCKET)event.ident);
             }
         }
     }
@@ -1609,7 +1645,7 @@ void CConnman::SocketEventsKqueue(std::set<SOCKET> &recv_set, std::set<SOCKET> &
 #endif
 
 #ifdef USE_EPOLL
-void CConnman::SocketEventsEpoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll)
+void CConnman::SocketEventsEpoll(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll)
 {
     const size_t maxEvents = 64;
     epoll_event events[maxEvents];
@@ -1620,25 +1656,25 @@ void CConnman::SocketEventsEpoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &s
     for (int i = 0; i < n; i++) {
         auto& e = events[i];
         if((e.events & EPOLLERR) || (e.events & EPOLLHUP)) {
-            error_set.insert((SOCKET)e.data.fd);
+            error_set.push_back((SOCKET)e.data.fd);
             continue;
         }
 
         if (e.events & EPOLLIN) {
-            recv_set.insert((SOCKET)e.data.fd);
+            recv_set.push_back((SOCKET)e.data.fd);
         }
 
         if (e.events & EPOLLOUT) {
-            send_set.insert((SOCKET)e.data.fd);
+            send_set.push_back((SOCKET)e.data.fd);
         }
     }
 }
 #endif
 
 #ifdef USE_POLL
-void CConnman::SocketEventsPoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll)
+void CConnman::SocketEventsPoll(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll)
 {
-    std::set<SOCKET> recv_select_set, send_select_set, error_select_set;
+    std::vector<SOCKET> recv_select_set, send_select_set, error_select_set;
     if (!GenerateSelectSet(recv_select_set, send_select_set, error_select_set)) {
         if (!fOnlyPoll) interruptNet.sleep_for(std::chrono::milliseconds(SELECT_TIMEOUT_MILLISECONDS));
         return;
@@ -1677,16 +1713,16 @@ void CConnman::SocketEventsPoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &se
     if (interruptNet) return;
 
     for (struct pollfd pollfd_entry : vpollfds) {
-        if (pollfd_entry.revents & POLLIN)            recv_set.insert(pollfd_entry.fd);
-        if (pollfd_entry.revents & POLLOUT)           send_set.insert(pollfd_entry.fd);
-        if (pollfd_entry.revents & (POLLERR|POLLHUP)) error_set.insert(pollfd_entry.fd);
+        if (pollfd_entry.revents & POLLIN)            recv_set.push_back(pollfd_entry.fd);
+        if (pollfd_entry.revents & POLLOUT)           send_set.push_back(pollfd_entry.fd);
+        if (pollfd_entry.revents & (POLLERR|POLLHUP)) error_set.push_back(pollfd_entry.fd);
     }
 }
 #endif
 
-void CConnman::SocketEventsSelect(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll)
+void CConnman::SocketEventsSelect(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll)
 {
-    std::set<SOCKET> recv_select_set, send_select_set, error_select_set;
+    std::vector<SOCKET> recv_select_set, send_select_set, error_select_set;
     if (!GenerateSelectSet(recv_select_set, send_select_set, error_select_set)) {
         interruptNet.sleep_for(std::chrono::milliseconds(SELECT_TIMEOUT_MILLISECONDS));
         return;
@@ -1742,24 +1778,24 @@ void CConnman::SocketEventsSelect(std::set<SOCKET> &recv_set, std::set<SOCKET> &
 
     for (SOCKET hSocket : recv_select_set) {
         if (FD_ISSET(hSocket, &fdsetRecv)) {
-            recv_set.insert(hSocket);
+            recv_set.push_back(hSocket);
         }
     }
 
     for (SOCKET hSocket : send_select_set) {
         if (FD_ISSET(hSocket, &fdsetSend)) {
-            send_set.insert(hSocket);
+            send_set.push_back(hSocket);
         }
     }
 
     for (SOCKET hSocket : error_select_set) {
         if (FD_ISSET(hSocket, &fdsetError)) {
-            error_set.insert(hSocket);
+            error_set.push_back(hSocket);
         }
     }
 }
 
-void CConnman::SocketEvents(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll)
+void CConnman::SocketEvents(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll)
 {
     switch (socketEventsMode) {
 #ifdef USE_KQUEUE
@@ -1805,12 +1841,22 @@ void CConnman::SocketHandler()
         }
     }
 
-    std::set<SOCKET> recv_set, send_set, error_set;
+    // Only a handful of sockets are reported per iteration by epoll and kqueue, so plain vectors
+    // with linear lookups are cheaper than building ordered sets
+    auto& recv_set = vRecvEvents;
+    auto& send_set = vSendEvents;
+    auto& error_set = vErrorEvents;
+    recv_set.clear();
+    send_set.clear();
+    error_set.clear();
     SocketEvents(recv_set, send_set, error_set, fOnlyPoll);
+    const auto contains = [](const std::vector<SOCKET>& sockets, SOCKET socket) {
+        return std::find(sockets.begin(), sockets.end(), socket) != sockets.end();
+    };
 
 #ifdef USE_WAKEUP_PIPE
     // drain the wakeup pipe
-    if (recv_set.count(wakeupPipe[0])) {
+    if (contains(recv_set, wakeupPipe[0])) {
         char buf[128];
         while (true) {
             int r = read(wakeupPipe[0], buf, sizeof(buf));
@@ -1828,7 +1874,7 @@ void CConnman::SocketHandler()
     //
     for (const ListenSocket& hListenSocket : vhListenSocket)
     {
-        if (recv_set.count(hListenSocket.socket) > 0)
+        if (contains(recv_set, hListenSocket.socket))
         {
             AcceptConnection(hListenSocket);
         }
@@ -1848,7 +1894,7 @@ void CConnman::SocketHandler()
             vErrorNodes.emplace_back(it->second);
         }
         for (auto hSocket : recv_set) {
-            if (error_set.count(hSocket)) {
+            if (!error_set.empty() && contains(error_set, hSocket)) {
                 // no need to handle it twice
                 continue;
             }
@@ -2006,7 +2052,7 @@ size_t CConnman::SocketRecvData(CNode *pnode)
                 pnode->nProcessQueueSize += nSizeAdded;
                 pnode->fPauseRecv = pnode->nProcessQueueSize > nReceiveFloodSize;
             }
-            WakeMessageHandler();
+            WakeMessageHandler(pnode->GetId());
         }
     }
     else if (nBytes == 0)
@@ -2063,9 +2109,21 @@ void CConnman::WakeMessageHandler()
 {
     {
         LOCK(mutexMsgProc);
-        fMsgProcWake = true;
+        std::fill(vMsgProcWake.begin(), vMsgProcWake.end(), true);
+    }
+    for (auto& cond : condMsgProc) {
+        cond.notify_one();
+    }
+}
+
+void CConnman::WakeMessageHandler(NodeId id)
+{
+    const int nShard = id % nMsgHandThreads;
+    {
+        LOCK(mutexMsgProc);
+        vMsgProcWake[nShard] = true;
     }
-    condMsgProc.notify_one();
+    condMsgProc[nShard].notify_one();
 }
 
 void CConnman::WakeSelect()
@@ -2930,7 +2988,7 @@ void CConnman::RelayInv(CInv& inv, const int minProtoVersion)
 
 
 
-void CConnman::ThreadMessageHandler()
+void CConnman::ThreadMessageHandler(int nShard)
 {
     int64_t nLastSendMessagesTimeMasternodes = 0;
 
@@ -2951,6 +3009,10 @@ void CConnman::ThreadMessageHandler()
             if (pnode->fDisconnect)
                 continue;
 
+            // Every peer is handled by exactly one thread, so its messages are still processed in order
+            if (pnode->GetId() % nMsgHandThreads != nShard)
+                continue;
+
             // Receive messages
             bool fMoreNodeWork = m_msgproc->ProcessMessages(pnode, flagInterruptMsgProc);
             fMoreWork |= (fMoreNodeWork && !pnode->fPauseSend);
@@ -2970,9 +3032,9 @@ void CConnman::ThreadMessageHandler()
 
         WAIT_LOCK(mutexMsgProc, lock);
         if (!fMoreWork) {
-            condMsgProc.wait_until(lock, std::chrono::steady_clock::now() + std::chrono::milliseconds(100), [this]() EXCLUSIVE_LOCKS_REQUIRED(mutexMsgProc) { return fMsgProcWake; });
+            condMsgProc[nShard].wait_until(lock, std::chrono::steady_clock::now() + std::chrono::milliseconds(100), [this, nShard]() EXCLUSIVE_LOCKS_REQUIRED(mutexMsgProc) { return vMsgProcWake[nShard]; });
         }
-        fMsgProcWake = false;
+        vMsgProcWake[nShard] = false;
     }
 }
 
@@ -3322,8 +3384,9 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 
     {
         LOCK(mutexMsgProc);
-        fMsgProcWake = false;
+        vMsgProcWake.assign(nMsgHandThreads, false);
     }
+    condMsgProc = std::vector<std::condition_variable>(nMsgHandThreads);
 
 #ifdef USE_WAKEUP_PIPE
     if (pipe(wakeupPipe) != 0) {
@@ -3395,7 +3458,10 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     threadOpenMasternodeConnections = std::thread(&util::TraceThread, "mncon", [this] { ThreadOpenMasternodeConnections(); });
 
     // Process messages
-    threadMessageHandler = std::thread(&util::TraceThread, "msghand", [this] { ThreadMessageHandler(); });
+    for (int i = 0; i < nMsgHandThreads; i++) {
+        std::string thread_name = i == 0 ? "msghand" : strprintf("msghand.%d", i);
+        threadMessageHandlers.emplace_back([this, i, thread_name] { util::TraceThread(thread_name.c_str(), [this, i] { ThreadMessageHandler(i); }); });
+    }
 
     if (connOptions.m_i2p_accept_incoming && m_i2p_sam_session.get() != nullptr) {
         threadI2PAcceptIncoming =
@@ -3436,7 +3502,9 @@ void CConnman::Interrupt()
         LOCK(mutexMsgProc);
         flagInterruptMsgProc = true;
     }
-    condMsgProc.notify_all();
+    for (auto& cond : condMsgProc) {
+        cond.notify_all();
+    }
 
     interruptNet();
     InterruptSocks5(true);
@@ -3459,8 +3527,11 @@ void CConnman::StopThreads()
     if (threadI2PAcceptIncoming.joinable()) {
         threadI2PAcceptIncoming.join();
     }
-    if (threadMessageHandler.joinable())
-        threadMessageHandler.join();
+    for (auto& thread : threadMessageHandlers) {
+        if (thread.joinable())
+            thread.join();
+    }
+    threadMessageHandlers.clear();
     if (threadOpenMasternodeConnections.joinable())
         threadOpenMasternodeConnections.join();
     if (threadOpenConnections.joinable())
@@ -101,6 +101,12 @@ static const int NUM_FDS_MESSAGE_CAPTURE = 1;
 static const bool DEFAULT_FORCEDNSSEED = false;
 static const size_t DEFAULT_MAXRECEIVEBUFFER = 5 * 1000;
 static const size_t DEFAULT_MAXSENDBUFFER    = 1 * 1000;
+/** Maximum number of queued send buffers that are handed to the kernel in a single sendmsg() call */
+static const size_t MAX_SEND_IOVECS = 64;
+/** -msghandthreads default: number of message handler threads, peers are assigned to one of them by id */
+static const int DEFAULT_MSGHAND_THREADS = 1;
+/** Maximum number of message handler threads */
+static const int MAX_MSGHAND_THREADS = 16;
 
 #if defined USE_KQUEUE
 #define DEFAULT_SOCKETEVENTS "kqueue"
@@ -253,6 +259,7 @@ public:
         std::vector<std::string> m_specified_outgoing;
         std::vector<std::string> m_added_nodes;
         SocketEventsMode socketEventsMode = SOCKETEVENTS_SELECT;
+        int nMsgHandThreads = DEFAULT_MSGHAND_THREADS;
         std::vector<bool> m_asmap;
         bool m_i2p_accept_incoming;
     };
@@ -282,6 +289,7 @@ public:
             vAddedNodes = connOptions.m_added_nodes;
         }
         socketEventsMode = connOptions.socketEventsMode;
+        nMsgHandThreads = std::clamp(connOptions.nMsgHandThreads, 1, MAX_MSGHAND_THREADS);
         m_onion_binds = connOptions.onion_binds;
     }
 
@@ -562,6 +570,8 @@ public:
     unsigned int GetReceiveFloodSize() const;
 
     void WakeMessageHandler();
+    /** Wake only the message handler thread which processes messages from this peer */
+    void WakeMessageHandler(NodeId id);
     void WakeSelect();
 
     /** Attempts to obfuscate tx time through exponentially distributed emitting.
@@ -593,7 +603,7 @@ private:
     void AddAddrFetch(const std::string& strDest);
     void ProcessAddrFetch();
     void ThreadOpenConnections(std::vector<std::string> connect);
-    void ThreadMessageHandler();
+    void ThreadMessageHandler(int nShard);
     void ThreadI2PAcceptIncoming();
     void AcceptConnection(const ListenSocket& hListenSocket);
 
@@ -615,18 +625,18 @@ private:
     void CalculateNumConnectionsChangedStats();
     /** Return true if the peer is inactive and should be disconnected. */
     bool InactivityCheck(const CNode& node) const;
-    bool GenerateSelectSet(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set);
+    bool GenerateSelectSet(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set);
 #ifdef USE_KQUEUE
-    void SocketEventsKqueue(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
+    void SocketEventsKqueue(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll);
 #endif
 #ifdef USE_EPOLL
-    void SocketEventsEpoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
+    void SocketEventsEpoll(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll);
 #endif
 #ifdef USE_POLL
-    void SocketEventsPoll(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
+    void SocketEventsPoll(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll);
 #endif
-    void SocketEventsSelect(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
-    void SocketEvents(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
+    void SocketEventsSelect(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll);
+    void SocketEvents(std::vector<SOCKET> &recv_set, std::vector<SOCKET> &send_set, std::vector<SOCKET> &error_set, bool fOnlyPoll);
     void SocketHandler();
     void ThreadSocketHandler();
     void ThreadDNSAddressSeed();
@@ -783,10 +793,11 @@ private:
     /** SipHasher seeds for deterministic randomness */
     const uint64_t nSeed0, nSeed1;
 
-    /** flag for waking the message processor. */
-    bool fMsgProcWake GUARDED_BY(mutexMsgProc);
+    /** flags for waking the message processor threads, one per thread. */
+    std::vector<bool> vMsgProcWake GUARDED_BY(mutexMsgProc);
 
-    std::condition_variable condMsgProc;
+    /** condition variables of the message processor threads, one per thread. */
+    std::vector<std::condition_variable> condMsgProc;
     Mutex mutexMsgProc;
     std::atomic<bool> flagInterruptMsgProc{false};
 
@@ -811,6 +822,15 @@ private:
     std::atomic<bool> wakeupSelectNeeded{false};
 
     SocketEventsMode socketEventsMode;
+
+    /**
+     * Sockets reported by SocketEvents() in the last SocketHandler() iteration. Only used by the
+     * socket handler thread, they are kept around so their storage is reused between iterations.
+     */
+    std::vector<SOCKET> vRecvEvents, vSendEvents, vErrorEvents;
+
+    /** Number of message handler threads, peers are sharded across them by NodeId */
+    int nMsgHandThreads{DEFAULT_MSGHAND_THREADS};
 #ifdef USE_KQUEUE
     int kqueuefd{-1};
 #endif
@@ -830,7 +850,7 @@ private:
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
     std::thread threadOpenMasternodeConnections;
-    std::thread threadMessageHandler;
+    std::vector<std::thread> threadMessageHandlers;
     std::thread threadI2PAcceptIncoming;
 
     /** flag for deciding to connect to an extra outbound peer,
@@ -966,6 +986,7 @@ public:
     bool m_manual_connection;
     int nStartingHeight;
     uint64_t nSendBytes;
+    uint64_t nSendCalls;
     mapMsgCmdSize mapSendBytesPerMsgCmd;
     uint64_t nRecvBytes;
     mapMsgCmdSize mapRecvBytesPerMsgCmd;
@@ -1125,6 +1146,8 @@ public:
     /** Offset inside the first vSendMsg already sent */
     size_t nSendOffset GUARDED_BY(cs_vSend){0};
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
+    /** Number of successful send calls, nSendBytes / nSendCalls is the average number of bytes per syscall */
+    uint64_t nSendCalls GUARDED_BY(cs_vSend){0};
     std::list<std::vector<unsigned char>> vSendMsg GUARDED_BY(cs_vSend);
     std::atomic<size_t> nSendMsgSize{0};
     RecursiveMutex cs_vSend;
@@ -346,6 +346,19 @@ private:
     /** Whether this node is running in blocks only mode */
     const bool m_ignore_incoming_txs;
 
+    /**
+     * Serializes message processing across the message handler threads (see
+     * -msghandthreads). Only the handlers in IsParallelMessage() and serving of
+     * queued getdata requests may run for several peers concurrently.
+     */
+    Mutex m_msgproc_mutex;
+    /**
+     * Serializes the messages of IsLLMQMessage() across the message handler
+     * threads. They are processed concurrently with everything behind
+     * m_msgproc_mutex.
+     */
+    Mutex m_llmq_msgproc_mutex;
+
     /** Protects m_peer_map */
     mutable Mutex m_peer_mutex;
     /**
@@ -2040,6 +2053,15 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, const CChainParams& chai
         std::shared_ptr<const CBlock> pblock;
         if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
             pblock = a_recent_block;
+        } else if (inv.IsMsgBlk()) {
+            // Fast-path: the block is served straight from the block file without
+            // deserializing it, as the network format matches the format on disk
+            std::vector<uint8_t> block_data;
+            if (!ReadRawBlockFromDisk(block_data, pindex->GetBlockPos(), chainparams.MessageStart())) {
+                assert(!"cannot load block from disk");
+            }
+            connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, Span{block_data}));
+            // Don't set pblock as we've sent the block
         } else {
             // Send block from disk
             std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
@@ -4508,6 +4530,41 @@ bool PeerManagerImpl::MaybeDiscourageAndDisconnect(CNode& pnode)
     return true;
 }
 
+/**
+ * Messages whose handlers only touch the sending peer's own state or state that is
+ * protected by its own locks, so they may be processed while other peers' messages
+ * are processed on another message handler thread. A peer is always handled by the
+ * same thread, so per-peer state needs no extra synchronization.
+ */
+static bool IsParallelMessage(const std::string& msg_type)
+{
+    return msg_type == NetMsgType::GETDATA ||
+           msg_type == NetMsgType::PING ||
+           msg_type == NetMsgType::PONG;
+}
+
+/**
+ * LLMQ, InstantSend and ChainLock messages. Their handlers only queue work for
+ * or update the LLMQ managers, which are also driven by their own worker threads
+ * and keep their state behind their own locks. They only share cs_main and the
+ * per-peer state with the rest of the message processing.
+ */
+static bool IsLLMQMessage(const std::string& msg_type)
+{
+    return msg_type == NetMsgType::QSIGSESANN ||
+           msg_type == NetMsgType::QSIGSHARESINV ||
+           msg_type == NetMsgType::QGETSIGSHARES ||
+           msg_type == NetMsgType::QBSIGSHARES ||
+           msg_type == NetMsgType::QSIGSHARE ||
+           msg_type == NetMsgType::QSIGREC ||
+           msg_type == NetMsgType::QCONTRIB ||
+           msg_type == NetMsgType::QCOMPLAINT ||
+           msg_type == NetMsgType::QJUSTIFICATION ||
+           msg_type == NetMsgType::QPCOMMITMENT ||
+           msg_type == NetMsgType::ISDLOCK ||
+           msg_type == NetMsgType::CLSIG;
+}
+
 bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
 {
     bool fMoreWork = false;
@@ -4523,6 +4580,7 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     }
 
     {
+        LOCK(m_msgproc_mutex);
         LOCK2(cs_main, g_cs_orphans);
         if (!peer->m_orphan_work_set.empty()) {
             ProcessOrphanTx(peer->m_orphan_work_set);
@@ -4570,7 +4628,15 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     unsigned int nMessageSize = msg.m_message_size;
 
     try {
-        ProcessMessage(*pfrom, msg_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        if (pfrom->nTimeFirstMessageReceived != 0 && IsParallelMessage(msg_type)) {
+            ProcessMessage(*pfrom, msg_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        } else if (pfrom->nTimeFirstMessageReceived != 0 && IsLLMQMessage(msg_type)) {
+            LOCK(m_llmq_msgproc_mutex);
+            ProcessMessage(*pfrom, msg_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        } else {
+            LOCK(m_msgproc_mutex);
+            ProcessMessage(*pfrom, msg_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        }
         if (interruptMsgProc) return false;
         {
             LOCK(peer->m_getdata_requests_mutex);
@@ -4795,6 +4861,8 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 {
     assert(m_llmq_ctx);
 
+    LOCK(m_msgproc_mutex);
+
     const Consensus::Params& consensusParams = m_chainparams.GetConsensus();
 
     // We must call MaybeDiscourageAndDisconnect first, to ensure that we'll
@@ -0,0 +1,167 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockcompression.h>
+
+#include <crypto/common.h>
+
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr size_t MIN_MATCH{4};
+constexpr size_t MAX_OFFSET{0xffff};
+constexpr int HASH_BITS{16};
+constexpr size_t HEADER_SIZE{5};
+
+/**
+ * Byte strings seen in most BiblePay blocks. Matches can reach back into
+ * this text as if it preceded the block, so the most frequent strings are
+ * kept close to the end.
+ */
+constexpr std::string_view DICTIONARY_V1{
+    // Sidechain, NFT, atomic trade and governance payloads
+    "<MK>SC</MK><MV><sc><objtype>nft</objtype><objtype>atomictrade</objtype><objtype>asset</objtype>"
+    "<data></data></sc></MV><url>https://</url><signer></signer><sig></sig><msg></msg><key></key>"
+    "<value></value><hash></hash><height></height><ATOMICTRANSACTION><ATOMIC></ATOMIC>"
+    "</ATOMICTRANSACTION><BOMSG></BOMSG><BOSIG></BOSIG><AMOUNT></AMOUNT><BALANCE></BALANCE>"
+    "<BBPPRICE></BBPPRICE><BTCPRICE></BTCPRICE><PRICES><PRICE></PRICE></PRICES><TRADES></TRADES>"
+    "<QTDATA><QTPHASE></QTPHASE></QTDATA><PROPOSALS></PROPOSALS><VOTES><VOTEDATA></VOTEDATA></VOTES>"
+    "<SPORKS></SPORKS><RECIPIENTS><RECIPIENT></RECIPIENT></RECIPIENTS><ADDRESSES></ADDRESSES>"
+    "<PAYMENTS></PAYMENTS><TXID></TXID><PublicKey></PublicKey><HEX></HEX><CACTION></CACTION>"
+    // GSC contract tables
+    "<ROW></ROW><row><col></col><col></col><col></col></row><row><col></col><col></col><col></col></row>"
+    // Standard scripts: P2PKH and P2SH outputs, coinbase and special transaction versions
+    "\xff\xff\xff\xff\x01\x00\x00\x00\x03\x00\x05\x00\x03\x00\x00\x00"
+    "\x17\xa9\x14\x87\x00\x00\x00\x00\x00\x00\x00\x00\x88\xac\x19\x76\xa9\x14"
+    // Mined block version strings, in every coinbase
+    "<MINERGUID></MINERGUID><SANC>?</SANC><SANC></SANC></VER><SANC><VER>v0.1"sv};
+
+uint32_t Hash(const uint8_t* p)
+{
+    return (ReadLE32(p) * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t len)
+{
+    while (len >= 255) {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back(len);
+}
+
+void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_len, size_t offset, size_t match_len)
+{
+    const size_t match_code = match_len ? match_len - MIN_MATCH : 0;
+    out.push_back((std::min<size_t>(literal_len, 15) << 4) | std::min<size_t>(match_code, 15));
+    if (literal_len >= 15) WriteLength(out, literal_len - 15);
+    out.insert(out.end(), literals, literals + literal_len);
+    if (match_len == 0) return; // last sequence
+    out.push_back(offset & 0xff);
+    out.push_back(offset >> 8);
+    if (match_code >= 15) WriteLength(out, match_code - 15);
+}
+
+bool ReadLength(Span<const uint8_t> in, size_t& pos, size_t& len)
+{
+    uint8_t b;
+    do {
+        if (pos >= in.size()) return false;
+        b = in[pos++];
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+std::vector<uint8_t> CompressBlockData(Span<const uint8_t> data)
+{
+    const std::string_view& dict = DICTIONARY_V1;
+
+    // The dictionary and the data form one window
+    std::vector<uint8_t> buf(dict.size() + data.size());
+    std::memcpy(buf.data(), dict.data(), dict.size());
+    if (!data.empty()) std::memcpy(buf.data() + dict.size(), data.data(), data.size());
+
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + data.size() / 2);
+    out.push_back(BLOCK_DICTIONARY_V1);
+    out.resize(HEADER_SIZE);
+    WriteLE32(out.data() + 1, data.size());
+
+    std::vector<int32_t> table(size_t{1} << HASH_BITS, -1);
+    for (size_t i = 0; i + MIN_MATCH <= dict.size(); ++i) {
+        table[Hash(&buf[i])] = i;
+    }
+
+    const size_t end = buf.size();
+    size_t anchor = dict.size();
+    size_t pos = dict.size();
+    while (pos + MIN_MATCH <= end) {
+        const uint32_t h = Hash(&buf[pos]);
+        const int32_t ref = table[h];
+        table[h] = pos;
+        if (ref < 0 || pos - ref > MAX_OFFSET || std::memcmp(&buf[ref], &buf[pos], MIN_MATCH) != 0) {
+            ++pos;
+            continue;
+        }
+
+        size_t len = MIN_MATCH;
+        while (pos + len < end && buf[ref + len] == buf[pos + len]) ++len;
+        WriteSequence(out, &buf[anchor], pos - anchor, pos - ref, len);
+        for (size_t i = pos + 1; i < pos + len && i + MIN_MATCH <= end; ++i) {
+            table[Hash(&buf[i])] = i;
+        }
+        pos += len;
+        anchor = pos;
+    }
+    WriteSequence(out, buf.data() + anchor, end - anchor, 0, 0);
+    return out;
+}
+
+bool DecompressBlockData(Span<const uint8_t> in, std::vector<uint8_t>& data, uint64_t max_size)
+{
+    if (in.size() < HEADER_SIZE || in[0] != BLOCK_DICTIONARY_V1) return false;
+    const std::string_view& dict = DICTIONARY_V1;
+    const uint64_t size = ReadLE32(in.data() + 1);
+    if (size > max_size) return false;
+
+    std::vector<uint8_t> buf(dict.size() + size);
+    std::memcpy(buf.data(), dict.data(), dict.size());
+    size_t out = dict.size();
+    size_t pos = HEADER_SIZE;
+    while (true) {
+        if (pos >= in.size()) return false;
+        const uint8_t token = in[pos++];
+
+        size_t literal_len = token >> 4;
+        if (literal_len == 15 && !ReadLength(in, pos, literal_len)) return false;
+        if (literal_len > in.size() - pos || literal_len > buf.size() - out) return false;
+        if (literal_len) std::memcpy(&buf[out], &in[pos], literal_len);
+        pos += literal_len;
+        out += literal_len;
+        if (pos == in.size()) break;
+
+        if (in.size() - pos < 2) return false;
+        const size_t offset = in[pos] | (size_t{in[pos + 1]} << 8);
+        pos += 2;
+        size_t match_len = token & 15;
+        if (match_len == 15 && !ReadLength(in, pos, match_len)) return false;
+        match_len += MIN_MATCH;
+        if (offset == 0 || offset > out || match_len > buf.size() - out) return false;
+        // Byte by byte, as the match may overlap the bytes it produces
+        for (size_t i = 0; i < match_len; ++i, ++out) {
+            buf[out] = buf[out - offset];
+        }
+    }
+    if (out != buf.size()) return false;
+
+    data.assign(buf.begin() + dict.size(), buf.end());
+    return true;
+}
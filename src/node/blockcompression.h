@@ -0,0 +1,41 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKCOMPRESSION_H
+#define BITCOIN_NODE_BLOCKCOMPRESSION_H
+
+#include <span.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compression of serialized blocks for storage in the block files.
+ *
+ * The format is a byte-oriented LZ77 variant in the style of LZ4: a sequence
+ * of (literals, back reference) pairs with 16 bit offsets. The window starts
+ * out primed with a fixed dictionary of byte strings that are common in
+ * BiblePay blocks (the sTxOutMessage XML tags, coinbase version strings and
+ * standard script templates), so that even the short payloads of a single
+ * block compress well. The dictionary is identified by the first byte of the
+ * compressed data and must never change once released; a new dictionary gets
+ * a new id.
+ *
+ * Compressed data: <dictionary id:1> <uncompressed size:LE32> <sequences>
+ */
+
+/** Dictionary used for newly compressed data */
+static constexpr uint8_t BLOCK_DICTIONARY_V1{1};
+
+/** Compress a serialized block. The result may be larger than the input. */
+std::vector<uint8_t> CompressBlockData(Span<const uint8_t> data);
+
+/**
+ * Reverse CompressBlockData.
+ * @returns false if the data is corrupt, uses an unknown dictionary or
+ *          decompresses to more than max_size bytes.
+ */
+bool DecompressBlockData(Span<const uint8_t> compressed, std::vector<uint8_t>& data, uint64_t max_size);
+
+#endif // BITCOIN_NODE_BLOCKCOMPRESSION_H
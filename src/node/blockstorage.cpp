@@ -12,9 +12,11 @@
 #include <flatfile.h>
 #include <fs.h>
 #include <masternode/node.h>
+#include <node/blockcompression.h>
 #include <pow.h>
 #include <shutdown.h>
 #include <streams.h>
+#include <util/strencodings.h>
 #include <util/system.h>
 #include <validation.h>
 #include <walletinitinterface.h>
@@ -22,7 +24,9 @@
 // From validation. TODO move here
 bool FindBlockPos(FlatFilePos& pos, unsigned int nAddSize, unsigned int nHeight, CChain& active_chain, uint64_t nTime, bool fKnown = false);
 
-static bool WriteBlockToDisk(const CBlock& block, FlatFilePos& pos, const CMessageHeader::MessageStartChars& messageStart)
+bool fBlockCompression = DEFAULT_BLOCK_COMPRESSION;
+
+static bool WriteBlockToDisk(Span<const uint8_t> record, bool compressed, FlatFilePos& pos, const CMessageHeader::MessageStartChars& messageStart)
 {
     // Open history file to append
     CAutoFile fileout(OpenBlockFile(pos), SER_DISK, CLIENT_VERSION);
@@ -31,8 +35,8 @@ static bool WriteBlockToDisk(const CBlock& block, FlatFilePos& pos, const CMessa
     }
 
     // Write index header
-    unsigned int nSize = GetSerializeSize(block, fileout.GetVersion());
-    fileout << messageStart << nSize;
+    unsigned int nSize = record.size();
+    fileout << messageStart << (compressed ? nSize | BLOCK_RECORD_COMPRESSED : nSize);
 
     // Write block
     long fileOutPos = ftell(fileout.Get());
@@ -40,24 +44,110 @@ static bool WriteBlockToDisk(const CBlock& block, FlatFilePos& pos, const CMessa
         return error("WriteBlockToDisk: ftell failed");
     }
     pos.nPos = (unsigned int)fileOutPos;
-    fileout << block;
+    fileout.write(AsBytes(record));
 
     return true;
 }
 
+/** Read the record at pos, decompressing it if needed, so that block holds the block in network format */
+static bool ReadBlockRecord(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start)
+{
+    FlatFilePos hpos = pos;
+    hpos.nPos -= 8; // Seek back 8 bytes for meta header
+    CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return error("%s: OpenBlockFile failed for %s", __func__, pos.ToString());
+    }
+
+    try {
+        CMessageHeader::MessageStartChars blk_start;
+        unsigned int blk_size;
+
+        filein >> blk_start >> blk_size;
+
+        if (memcmp(blk_start, message_start, CMessageHeader::MESSAGE_START_SIZE)) {
+            return error("%s: Block magic mismatch for %s: %s versus expected %s", __func__, pos.ToString(),
+                         HexStr(blk_start), HexStr(message_start));
+        }
+
+        const bool compressed = blk_size & BLOCK_RECORD_COMPRESSED;
+        blk_size &= ~BLOCK_RECORD_COMPRESSED;
+        if (blk_size > MAX_SIZE) {
+            return error("%s: Block data is larger than maximum deserialization size for %s: %s versus %s", __func__, pos.ToString(),
+                         blk_size, MAX_SIZE);
+        }
+
+        if (!compressed) {
+            block.resize(blk_size); // Zeroing of memory is intentional here
+            filein.read(MakeWritableByteSpan(block));
+            return true;
+        }
+
+        std::vector<uint8_t> record(blk_size);
+        filein.read(MakeWritableByteSpan(record));
+        if (!DecompressBlockData(record, block, MAX_SIZE)) {
+            return error("%s: Corrupt compressed block data for %s", __func__, pos.ToString());
+        }
+    } catch (const std::exception& e) {
+        return error("%s: Read from block file failed: %s for %s", __func__, e.what(), pos.ToString());
+    }
+
+    return true;
+}
+
+FILE* OpenBlockRecord(const FlatFilePos& pos, bool& compressed, std::vector<uint8_t>& data)
+{
+    FlatFilePos hpos = pos;
+    hpos.nPos -= 4; // Seek back to the size field of the meta header
+    CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return nullptr;
+    }
+    try {
+        unsigned int blk_size;
+        filein >> blk_size;
+        compressed = blk_size & BLOCK_RECORD_COMPRESSED;
+        if (compressed) {
+            blk_size &= ~BLOCK_RECORD_COMPRESSED;
+            if (blk_size > MAX_SIZE) {
+                error("%s: Block data is larger than maximum deserialization size for %s: %s versus %s", __func__, pos.ToString(),
+                      blk_size, MAX_SIZE);
+                return nullptr;
+            }
+            std::vector<uint8_t> record(blk_size);
+            filein.read(MakeWritableByteSpan(record));
+            if (!DecompressBlockData(record, data, MAX_SIZE)) {
+                error("%s: Corrupt compressed block data for %s", __func__, pos.ToString());
+                return nullptr;
+            }
+        }
+    } catch (const std::exception& e) {
+        error("%s: Read from block file failed: %s for %s", __func__, e.what(), pos.ToString());
+        return nullptr;
+    }
+    return filein.release();
+}
+
 bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::Params& consensusParams)
 {
     block.SetNull();
 
     // Open history file to read
-    CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
+    bool compressed;
+    std::vector<uint8_t> data;
+    CAutoFile filein(OpenBlockRecord(pos, compressed, data), SER_DISK, CLIENT_VERSION);
     if (filein.IsNull()) {
         return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
     }
 
     // Read block
     try {
-        filein >> block;
+        if (compressed) {
+            CDataStream ssBlock(data, SER_DISK, CLIENT_VERSION);
+            ssBlock >> block;
+        } else {
+            filein >> block;
+        }
     } catch (const std::exception& e) {
         return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
     }
@@ -84,20 +174,59 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
     return true;
 }
 
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start)
+{
+    return ReadBlockRecord(block, pos, message_start);
+}
+
+/** Size of the record at pos, including its header, as it is stored on disk */
+static bool ReadBlockRecordSize(const FlatFilePos& pos, unsigned int& nRecordSize)
+{
+    FlatFilePos hpos = pos;
+    hpos.nPos -= 4; // Seek back to the size field of the meta header
+    CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return false;
+    }
+    try {
+        filein >> nRecordSize;
+    } catch (const std::exception&) {
+        return false;
+    }
+    nRecordSize = (nRecordSize & ~BLOCK_RECORD_COMPRESSED) + 8;
+    return true;
+}
+
 /** Store block on disk. If dbp is non-nullptr, the file is known to already reside on disk */
 FlatFilePos SaveBlockToDisk(const CBlock& block, int nHeight, CChain& active_chain, const CChainParams& chainparams, const FlatFilePos* dbp)
 {
-    unsigned int nBlockSize = ::GetSerializeSize(block, CLIENT_VERSION);
     FlatFilePos blockPos;
+    std::vector<uint8_t> record;
+    bool compressed{false};
+    unsigned int nRecordSize;
     if (dbp != nullptr) {
         blockPos = *dbp;
+        // The record may be compressed, so its size on disk is not the serialized size
+        if (!ReadBlockRecordSize(blockPos, nRecordSize)) {
+            nRecordSize = ::GetSerializeSize(block, CLIENT_VERSION) + 8;
+        }
+    } else {
+        CVectorWriter{SER_DISK, CLIENT_VERSION, record, 0, block};
+        if (fBlockCompression) {
+            std::vector<uint8_t> compressed_record{CompressBlockData(record)};
+            if (compressed_record.size() < record.size()) {
+                record = std::move(compressed_record);
+                compressed = true;
+            }
+        }
+        nRecordSize = record.size() + 8;
     }
-    if (!FindBlockPos(blockPos, nBlockSize + 8, nHeight, active_chain, block.GetBlockTime(), dbp != nullptr)) {
+    if (!FindBlockPos(blockPos, nRecordSize, nHeight, active_chain, block.GetBlockTime(), dbp != nullptr)) {
         error("%s: FindBlockPos failed", __func__);
         return FlatFilePos();
     }
     if (dbp == nullptr) {
-        if (!WriteBlockToDisk(block, blockPos, chainparams.MessageStart())) {
+        if (!WriteBlockToDisk(record, compressed, blockPos, chainparams.MessageStart())) {
             AbortNode("Failed to write block");
             return FlatFilePos();
         }
@@ -25,10 +25,25 @@ struct Params;
 }
 
 static constexpr bool DEFAULT_STOPAFTERBLOCKIMPORT{false};
+static constexpr bool DEFAULT_BLOCK_COMPRESSION{false};
+
+/** Set in the size field of a block file record whose payload is compressed with CompressBlockData() */
+static constexpr uint32_t BLOCK_RECORD_COMPRESSED{0x80000000};
+
+/** Whether new blocks are written compressed. Blocks already on disk are readable either way. */
+extern bool fBlockCompression;
 
 /** Functions for disk access for blocks */
+/**
+ * Open the block file positioned at the start of the record at pos. Sets compressed if the record
+ * is stored compressed, in which case the decompressed block is returned in data and must be read
+ * from there instead of from the file.
+ */
+FILE* OpenBlockRecord(const FlatFilePos& pos, bool& compressed, std::vector<uint8_t>& data);
 bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::Params& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+/** Read the serialized block at pos without deserializing it. Compressed records are decompressed, so the result is always in network format. */
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start);
 
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex);
 
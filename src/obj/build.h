@@ -0,0 +1 @@
+// No build information available
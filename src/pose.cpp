@@ -4,6 +4,7 @@
 #include "init.h"
 #include "net.h"
 #include <shutdown.h>
+#include <util/tracespan.h>
 #include <validation.h>
 #include <validationinterface.h>
 
@@ -54,6 +55,7 @@ void ThreadPOVS(CConnman& connman)
         {
             if (!ShutdownRequested() && fPOVSEnabled && !fProcessing)
             {
+                TRACE_SPAN("POVS");
                 LOCK(cs_main);
                 {
                     fProcessing = true;
@@ -19,6 +19,7 @@
 #include <rpc/blockchain.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
+#include <statsd_client.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
@@ -236,7 +237,7 @@ static bool rest_headers(const CoreContext& context,
 
         std::string strHex = HexStr(ssHeader) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
     case RetFormat::JSON: {
@@ -246,7 +247,7 @@ static bool rest_headers(const CoreContext& context,
         }
         std::string strJSON = jsonHeaders.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -296,7 +297,7 @@ static bool rest_block(const CoreContext& context,
         ssBlock << block;
         std::string binaryBlock = ssBlock.str();
         req->WriteHeader("Content-Type", "application/octet-stream");
-        req->WriteReply(HTTP_OK, binaryBlock);
+        req->WriteReply(HTTP_OK, std::move(binaryBlock));
         return true;
     }
 
@@ -305,15 +306,15 @@ static bool rest_block(const CoreContext& context,
         ssBlock << block;
         std::string strHex = HexStr(ssBlock) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
     case RetFormat::JSON: {
-        UniValue objBlock = blockToJSON(block, tip, pblockindex, *llmq::chainLocksHandler, *llmq::quorumInstantSendManager, showTxDetails);
-        std::string strJSON = objBlock.write() + "\n";
+        std::string strJSON = blockToJSONString(block, tip, pblockindex, *llmq::chainLocksHandler, *llmq::quorumInstantSendManager, showTxDetails);
+        strJSON += '\n';
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
 
@@ -350,7 +351,7 @@ static bool rest_chaininfo(const CoreContext& context, HTTPRequest* req, const s
         UniValue chainInfoObject = getblockchaininfo(jsonRequest);
         std::string strJSON = chainInfoObject.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -374,7 +375,7 @@ static bool rest_mempool_info(const CoreContext& context, HTTPRequest* req, cons
 
         std::string strJSON = mempoolInfoObject.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -397,7 +398,7 @@ static bool rest_mempool_contents(const CoreContext& context, HTTPRequest* req,
 
         std::string strJSON = mempoolObject.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -446,7 +447,7 @@ static bool rest_tx(const CoreContext& context, HTTPRequest* req, const std::str
 
         std::string strHex = HexStr(ssTx) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
@@ -455,7 +456,7 @@ static bool rest_tx(const CoreContext& context, HTTPRequest* req, const std::str
         TxToUniv(*tx, hashBlock, objTx);
         std::string strJSON = objTx.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
 
@@ -615,7 +616,7 @@ static bool rest_getutxos(const CoreContext& context, HTTPRequest* req, const st
         std::string strHex = HexStr(ssGetUTXOResponse) + "\n";
 
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
@@ -645,7 +646,7 @@ static bool rest_getutxos(const CoreContext& context, HTTPRequest* req, const st
         // return json string
         std::string strJSON = objGetUTXOResponse.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -654,6 +655,27 @@ static bool rest_getutxos(const CoreContext& context, HTTPRequest* req, const st
     }
 }
 
+static bool rest_metrics(const CoreContext& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!statsClient.enabled()) {
+        return RESTERR(req, HTTP_NOT_FOUND, "metrics are disabled (use -statsenabled)");
+    }
+    std::string param;
+    const RetFormat rf = ParseDataFormat(param, strURIPart);
+
+    switch (rf) {
+    case RetFormat::UNDEF: {
+        // Prometheus text exposition format
+        req->WriteHeader("Content-Type", "text/plain; version=0.0.4");
+        req->WriteReply(HTTP_OK, statsClient.prometheus());
+        return true;
+    }
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: text at /rest/metrics)");
+    }
+    }
+}
+
 static bool rest_blockhash_by_height(const CoreContext& context, HTTPRequest* req,
                        const std::string& str_uri_part)
 {
@@ -717,6 +739,7 @@ static const struct {
       {"/rest/headers/", rest_headers},
       {"/rest/getutxos", rest_getutxos},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      {"/rest/metrics", rest_metrics},
 };
 
 void StartREST(const CoreContext& context)
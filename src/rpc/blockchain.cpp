@@ -67,6 +67,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <optional>
 
 struct CUpdatedBlock
 {
@@ -252,36 +253,78 @@ UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex
     return result;
 }
 
-UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, llmq::CChainLocksHandler& clhandler, llmq::CInstantSendManager& isman, bool txDetails)
+static UniValue blockTxToJSON(const CTransaction& tx, bool chainlocked, llmq::CInstantSendManager& isman, bool txDetails)
 {
-    UniValue result = blockheaderToJSON(tip, blockindex, clhandler, isman);
+    if (!txDetails) {
+        return tx.GetHash().GetHex();
+    }
+    UniValue objTx(UniValue::VOBJ);
+    TxToUniv(tx, uint256(), objTx, true);
+    bool fLocked = isman.IsLocked(tx.GetHash());
+    objTx.pushKV("instantlock", fLocked || chainlocked);
+    objTx.pushKV("instantlock_internal", fLocked);
+    return objTx;
+}
 
+//! Header fields and "size", the fields blockToJSON() and blockToJSONString() write before "tx"
+static UniValue blockHeadToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, llmq::CChainLocksHandler& clhandler, llmq::CInstantSendManager& isman)
+{
+    UniValue result = blockheaderToJSON(tip, blockindex, clhandler, isman);
     result.pushKV("size", (int)::GetSerializeSize(block, PROTOCOL_VERSION));
+    return result;
+}
+
+//! The "cbTx" field both block writers add after "tx", if the coinbase has a payload
+static std::optional<UniValue> blockCbTxToJSON(const CBlock& block)
+{
+    if (!block.vtx[0]->vExtraPayload.empty()) {
+        if (const auto opt_cbTx = GetTxPayload<CCbTx>(block.vtx[0]->vExtraPayload)) {
+            return opt_cbTx->ToJson();
+        }
+    }
+    return std::nullopt;
+}
+
+UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, llmq::CChainLocksHandler& clhandler, llmq::CInstantSendManager& isman, bool txDetails)
+{
+    UniValue result = blockHeadToJSON(block, tip, blockindex, clhandler, isman);
+    const bool chainlocked = result["chainlock"].get_bool();
     UniValue txs(UniValue::VARR);
     for(const auto& tx : block.vtx)
     {
-        if(txDetails)
-        {
-            UniValue objTx(UniValue::VOBJ);
-            TxToUniv(*tx, uint256(), objTx, true);
-            bool fLocked = isman.IsLocked(tx->GetHash());
-            objTx.pushKV("instantlock", fLocked || result["chainlock"].get_bool());
-            objTx.pushKV("instantlock_internal", fLocked);
-            txs.push_back(objTx);
-        }
-        else
-            txs.push_back(tx->GetHash().GetHex());
+        txs.push_back(blockTxToJSON(*tx, chainlocked, isman, txDetails));
     }
     result.pushKV("tx", txs);
-    if (!block.vtx[0]->vExtraPayload.empty()) {
-        if (const auto opt_cbTx = GetTxPayload<CCbTx>(block.vtx[0]->vExtraPayload)) {
-            result.pushKV("cbTx", opt_cbTx->ToJson());
-        }
+    if (const auto cbTx = blockCbTxToJSON(block)) {
+        result.pushKV("cbTx", *cbTx);
     }
 
     return result;
 }
 
+std::string blockToJSONString(const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, llmq::CChainLocksHandler& clhandler, llmq::CInstantSendManager& isman, bool txDetails)
+{
+    const UniValue head = blockHeadToJSON(block, tip, blockindex, clhandler, isman);
+    const bool chainlocked = head["chainlock"].get_bool();
+
+    // Write the head object without its closing brace and append the remaining keys by hand
+    std::string ret = head.write();
+    ret.pop_back();
+    ret += ",\"tx\":[";
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        if (i > 0) ret += ',';
+        ret += blockTxToJSON(*block.vtx[i], chainlocked, isman, txDetails).write();
+    }
+    ret += ']';
+    if (const auto cbTx = blockCbTxToJSON(block)) {
+        ret += ",\"cbTx\":";
+        ret += cbTx->write();
+    }
+    ret += '}';
+
+    return ret;
+}
+
 static UniValue getblockcount(const JSONRPCRequest& request)
 {
     RPCHelpMan{"getblockcount",
@@ -1010,16 +1053,9 @@ static UniValue getblockheaders(const JSONRPCRequest& request)
 
     ChainstateManager& chainman = EnsureChainman(node);
 
-    CChainState& active_chainstate = chainman.ActiveChainstate();
-    CChain& active_chain = active_chainstate.m_chain;
-
-    const CBlockIndex* pblockindex;
-    const CBlockIndex* tip;
-    {
-        LOCK(cs_main);
-        pblockindex = chainman.m_blockman.LookupBlockIndex(hash);
-        tip = active_chain.Tip();
-    }
+    const CBlockIndex* pblockindex{WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(hash))};
+    const auto active_chain = chainman.ActiveChainSnapshot();
+    const CBlockIndex* tip = active_chain->Tip();
 
     if (!pblockindex) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
@@ -1040,7 +1076,7 @@ static UniValue getblockheaders(const JSONRPCRequest& request)
 
     if (!fVerbose)
     {
-        for (; pblockindex; pblockindex = active_chain.Next(pblockindex))
+        for (; pblockindex; pblockindex = active_chain->Next(pblockindex))
         {
             CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
             ssBlock << pblockindex->GetBlockHeader();
@@ -1053,7 +1089,7 @@ static UniValue getblockheaders(const JSONRPCRequest& request)
     }
 
     LLMQContext& llmq_ctx = EnsureLLMQContext(node);
-    for (; pblockindex; pblockindex = active_chain.Next(pblockindex))
+    for (; pblockindex; pblockindex = active_chain->Next(pblockindex))
     {
         arrHeaders.push_back(blockheaderToJSON(tip, pblockindex, *llmq_ctx.clhandler, *llmq_ctx.isman));
         if (--nCount <= 0)
@@ -1066,8 +1102,11 @@ static UniValue getblockheaders(const JSONRPCRequest& request)
 static CBlock GetBlockChecked(const CBlockIndex* pblockindex)
 {
     CBlock block;
-    if (IsBlockPruned(pblockindex)) {
-        throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
+    {
+        LOCK(cs_main);
+        if (IsBlockPruned(pblockindex)) {
+            throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
+        }
     }
 
     if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus())) {
@@ -1083,8 +1122,11 @@ static CBlock GetBlockChecked(const CBlockIndex* pblockindex)
 static CBlockUndo GetUndoChecked(const CBlockIndex* pblockindex)
 {
     CBlockUndo blockUndo;
-    if (IsBlockPruned(pblockindex)) {
-        throw JSONRPCError(RPC_MISC_ERROR, "Undo data not available (pruned data)");
+    {
+        LOCK(cs_main);
+        if (IsBlockPruned(pblockindex)) {
+            throw JSONRPCError(RPC_MISC_ERROR, "Undo data not available (pruned data)");
+        }
     }
 
     if (!UndoReadFromDisk(blockUndo, pblockindex)) {
@@ -1113,7 +1155,6 @@ static UniValue getmerkleblocks(const JSONRPCRequest& request)
     }.Check(request);
 
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
-    LOCK(cs_main);
 
     CBloomFilter filter;
     std::string strFilter = request.params[0].get_str();
@@ -1125,7 +1166,7 @@ static UniValue getmerkleblocks(const JSONRPCRequest& request)
 
     uint256 hash(ParseHashV(request.params[1], "blockhash"));
 
-    const CBlockIndex* pblockindex = chainman.m_blockman.LookupBlockIndex(hash);
+    const CBlockIndex* pblockindex{WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(hash))};
     if (!pblockindex) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
     }
@@ -1142,7 +1183,8 @@ static UniValue getmerkleblocks(const JSONRPCRequest& request)
 
     UniValue arrMerkleBlocks(UniValue::VARR);
 
-    for (; pblockindex; pblockindex = chainman.ActiveChain().Next(pblockindex))
+    const auto active_chain = chainman.ActiveChainSnapshot();
+    for (; pblockindex; pblockindex = active_chain->Next(pblockindex))
     {
         if (--nCount < 0) {
             break;
@@ -1253,9 +1295,8 @@ static UniValue getblock(const JSONRPCRequest& request)
         if (!pblockindex) {
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
         }
-
-        block = GetBlockChecked(pblockindex);
     }
+    block = GetBlockChecked(pblockindex);
 
     if (verbosity <= 0)
     {
@@ -1840,8 +1881,6 @@ static UniValue getchaintips(const JSONRPCRequest& request)
     }.Check(request);
 
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
-    LOCK(cs_main);
-    CChain& active_chain = chainman.ActiveChain();
 
     /*
      * Idea: The set of chain tips is the active chain tip, plus orphan blocks which do not have another orphan building off of them.
@@ -1849,15 +1888,23 @@ static UniValue getchaintips(const JSONRPCRequest& request)
      *  - Make one pass through BlockIndex(), picking out the orphan blocks, and also storing a set of the orphan block's pprev pointers.
      *  - Iterate through the orphan blocks. If the block isn't pointed to by another orphan, it is a chain tip.
      *  - Add the active chain tip
+     *
+     * Only the pass through BlockIndex() and the status lookups need cs_main, the rest works on
+     * a snapshot of the active chain taken together with the pass.
      */
     std::set<const CBlockIndex*, CompareBlocksByHeight> setTips;
     std::set<const CBlockIndex*> setOrphans;
     std::set<const CBlockIndex*> setPrevs;
 
-    for (const std::pair<const uint256, CBlockIndex*>& item : chainman.BlockIndex()) {
-        if (!active_chain.Contains(item.second)) {
-            setOrphans.insert(item.second);
-            setPrevs.insert(item.second->pprev);
+    std::shared_ptr<const CChainSnapshot> active_chain;
+    {
+        LOCK(cs_main);
+        active_chain = chainman.ActiveChainSnapshot();
+        for (const std::pair<const uint256, CBlockIndex*>& item : chainman.BlockIndex()) {
+            if (!active_chain->Contains(item.second)) {
+                setOrphans.insert(item.second);
+                setPrevs.insert(item.second->pprev);
+            }
         }
     }
 
@@ -1868,7 +1915,7 @@ static UniValue getchaintips(const JSONRPCRequest& request)
     }
 
     // Always report the currently active tip.
-    setTips.insert(active_chain.Tip());
+    setTips.insert(active_chain->Tip());
 
     int nBranchMin = -1;
     int nCountMax = INT_MAX;
@@ -1879,48 +1926,63 @@ static UniValue getchaintips(const JSONRPCRequest& request)
     if(!request.params[1].isNull())
         nBranchMin = request.params[1].get_int();
 
-    /* Construct the output array.  */
-    UniValue res(UniValue::VARR);
+    std::vector<std::pair<const CBlockIndex*, const CBlockIndex*>> vTips;
     for (const CBlockIndex* block : setTips)
     {
-        const CBlockIndex* pindexFork = active_chain.FindFork(block);
+        const CBlockIndex* pindexFork = active_chain->FindFork(block);
         const int branchLen = block->nHeight - pindexFork->nHeight;
         if(branchLen < nBranchMin) continue;
 
         if(nCountMax-- < 1) break;
 
+        vTips.emplace_back(block, pindexFork);
+    }
+
+    std::vector<std::string> vStatus;
+    vStatus.reserve(vTips.size());
+    {
+        LOCK(cs_main);
+        for (const auto& [block, pindexFork] : vTips) {
+            std::string status;
+            if (active_chain->Contains(block)) {
+                // This block is part of the currently active chain.
+                status = "active";
+            } else if (block->nStatus & BLOCK_FAILED_MASK) {
+                // This block or one of its ancestors is invalid.
+                status = "invalid";
+            } else if (block->nStatus & BLOCK_CONFLICT_CHAINLOCK) {
+                // This block or one of its ancestors is conflicting with ChainLocks.
+                status = "conflicting";
+            } else if (!block->HaveTxsDownloaded()) {
+                // This block cannot be connected because full block data for it or one of its parents is missing.
+                status = "headers-only";
+            } else if (block->IsValid(BLOCK_VALID_SCRIPTS)) {
+                // This block is fully validated, but no longer part of the active chain. It was probably the active block once, but was reorganized.
+                status = "valid-fork";
+            } else if (block->IsValid(BLOCK_VALID_TREE)) {
+                // The headers for this block are valid, but it has not been validated. It was probably never part of the most-work chain.
+                status = "valid-headers";
+            } else {
+                // No clue.
+                status = "unknown";
+            }
+            vStatus.push_back(std::move(status));
+        }
+    }
+
+    /* Construct the output array.  */
+    UniValue res(UniValue::VARR);
+    for (size_t i = 0; i < vTips.size(); ++i)
+    {
+        const auto& [block, pindexFork] = vTips[i];
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("height", block->nHeight);
         obj.pushKV("hash", block->phashBlock->GetHex());
         obj.pushKV("difficulty", GetDifficulty(block));
         obj.pushKV("chainwork", block->nChainWork.GetHex());
-        obj.pushKV("branchlen", branchLen);
+        obj.pushKV("branchlen", block->nHeight - pindexFork->nHeight);
         obj.pushKV("forkpoint", pindexFork->phashBlock->GetHex());
-
-        std::string status;
-        if (active_chain.Contains(block)) {
-            // This block is part of the currently active chain.
-            status = "active";
-        } else if (block->nStatus & BLOCK_FAILED_MASK) {
-            // This block or one of its ancestors is invalid.
-            status = "invalid";
-        } else if (block->nStatus & BLOCK_CONFLICT_CHAINLOCK) {
-            // This block or one of its ancestors is conflicting with ChainLocks.
-            status = "conflicting";
-        } else if (!block->HaveTxsDownloaded()) {
-            // This block cannot be connected because full block data for it or one of its parents is missing.
-            status = "headers-only";
-        } else if (block->IsValid(BLOCK_VALID_SCRIPTS)) {
-            // This block is fully validated, but no longer part of the active chain. It was probably the active block once, but was reorganized.
-            status = "valid-fork";
-        } else if (block->IsValid(BLOCK_VALID_TREE)) {
-            // The headers for this block are valid, but it has not been validated. It was probably never part of the most-work chain.
-            status = "valid-headers";
-        } else {
-            // No clue.
-            status = "unknown";
-        }
-        obj.pushKV("status", status);
+        obj.pushKV("status", vStatus[i]);
 
         res.push_back(obj);
     }
@@ -2296,7 +2358,6 @@ static UniValue getblockstats(const JSONRPCRequest& request)
     }
 
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
-    LOCK(cs_main);
     CBlockIndex* pindex{ParseHashOrHeight(request.params[0], chainman)};
     CHECK_NONFATAL(pindex != nullptr);
 
@@ -2481,7 +2542,6 @@ static UniValue getspecialtxes(const JSONRPCRequest& request)
     const NodeContext& node = EnsureAnyNodeContext(request.context);
 
     ChainstateManager& chainman = EnsureChainman(node);
-    LOCK(cs_main);
 
     CTxMemPool& mempool = EnsureMemPool(node);
     LLMQContext& llmq_ctx = EnsureLLMQContext(node);
@@ -2515,7 +2575,7 @@ static UniValue getspecialtxes(const JSONRPCRequest& request)
         }
     }
 
-    const CBlockIndex* pblockindex = chainman.m_blockman.LookupBlockIndex(blockhash);
+    const CBlockIndex* pblockindex{WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(blockhash))};
     if (!pblockindex) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
     }
@@ -3962,14 +4022,14 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      {} },
     { "blockchain",         "getchaintxstats",        &getchaintxstats,        {"nblocks", "blockhash"} },
     { "blockchain",         "getblockstats",          &getblockstats,          {"hash_or_height", "stats"} },
-    { "blockchain",         "getbestblockhash",       &getbestblockhash,       {} },
+    { "blockchain",         "getbestblockhash",       &getbestblockhash,       {}, /*parallel_batch=*/true },
     { "blockchain",         "getbestchainlock",       &getbestchainlock,       {} },
-    { "blockchain",         "getblockcount",          &getblockcount,          {} },
-    { "blockchain",         "getblock",               &getblock,               {"blockhash","verbosity|verbose"} },
+    { "blockchain",         "getblockcount",          &getblockcount,          {}, /*parallel_batch=*/true },
+    { "blockchain",         "getblock",               &getblock,               {"blockhash","verbosity|verbose"}, /*parallel_batch=*/true },
     { "blockchain",         "getblockhashes",         &getblockhashes,         {"high","low"} },
-    { "blockchain",         "getblockhash",           &getblockhash,           {"height"} },
-    { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"} },
-    { "blockchain",         "getblockheaders",        &getblockheaders,        {"blockhash","count","verbose"} },
+    { "blockchain",         "getblockhash",           &getblockhash,           {"height"}, /*parallel_batch=*/true },
+    { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"}, /*parallel_batch=*/true },
+    { "blockchain",         "getblockheaders",        &getblockheaders,        {"blockhash","count","verbose"}, /*parallel_batch=*/true },
     { "blockchain",         "getmerkleblocks",        &getmerkleblocks,        {"filter","blockhash","count"} },
     { "blockchain",         "getchaintips",           &getchaintips,           {"count","branchlen"} },
     { "blockchain",         "getdifficulty",          &getdifficulty,          {} },
@@ -3979,7 +4039,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getmempoolinfo",         &getmempoolinfo,         {} },
     { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"} },
     { "blockchain",         "getspecialtxes",         &getspecialtxes,         {"blockhash", "type", "count", "skip", "verbosity"} },
-    { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"} },
+    { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"}, /*parallel_batch=*/true },
     { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {"hash_type", "hash_or_height", "use_index"} },
     { "blockchain",         "pruneblockchain",        &pruneblockchain,        {"height"} },
     { "blockchain",         "savemempool",            &savemempool,            {} },
@@ -149,6 +149,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "lockunspent", 0, "unlock" },
     { "lockunspent", 1, "transactions" },
     { "importprivkey", 2, "rescan" },
+    { "importprivkey", 3, "use_blockfilter" },
     { "importelectrumwallet", 1, "index" },
     { "importaddress", 2, "rescan" },
     { "importaddress", 3, "p2sh" },
@@ -206,6 +207,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "echojson", 9, "arg9" },
     { "rescanblockchain", 0, "start_height"},
     { "rescanblockchain", 1, "stop_height"},
+    { "rescanblockchain", 2, "use_blockfilter"},
     { "wipewallettxes", 0, "keep_confirmed"},
     { "createwallet", 1, "disable_private_keys"},
     { "createwallet", 2, "blank"},
@@ -9,6 +9,7 @@
 #include <addressindex.h>
 #include <chainparams.h>
 #include <consensus/consensus.h>
+#include <dbwrapper.h>
 #include <deploymentstatus.h>
 #include <evo/mnauth.h>
 #include <httpserver.h>
@@ -30,11 +31,13 @@
 #include <util/message.h> // For MessageSign(), MessageVerify()
 #include <util/strencodings.h>
 #include <util/system.h>
+#include <util/tracespan.h>
 #include <validation.h>
 
 #include <masternode/sync.h>
 #include <spork.h>
 
+#include <numeric>
 #include <stdint.h>
 #ifdef HAVE_MALLOC_INFO
 #include <malloc.h>
@@ -1183,6 +1186,19 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
                         {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                         {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                     }},
+                    {RPCResult::Type::ARR, "databases", "Settings and memory usage of the open LevelDB databases",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "name", "Name of the database, as used by -dbprofile"},
+                            {RPCResult::Type::NUM, "cache", "Cache size in bytes assigned to the database"},
+                            {RPCResult::Type::NUM, "blockcache", "Share of the cache used for the block cache, in percent"},
+                            {RPCResult::Type::NUM, "writebuffer", "Share of the cache used for each write buffer, in percent"},
+                            {RPCResult::Type::NUM, "bloombits", "Bits per key of the bloom filter, 0 if disabled"},
+                            {RPCResult::Type::NUM, "maxfilesize", "Target size of table files in MiB, 0 for the LevelDB default"},
+                            {RPCResult::Type::NUM, "usage", "Approximate memory usage in bytes (leveldb.approximate-memory-usage)"},
+                        }},
+                    }},
                 }
             },
             RPCResult{"mode \"mallocinfo\"",
@@ -1199,6 +1215,19 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+        UniValue databases(UniValue::VARR);
+        for (const DBWrapperInfo& info : GetDBWrapperInfo()) {
+            UniValue db(UniValue::VOBJ);
+            db.pushKV("name", info.name);
+            db.pushKV("cache", (uint64_t)info.cache_size);
+            db.pushKV("blockcache", info.profile.block_cache_percent);
+            db.pushKV("writebuffer", info.profile.write_buffer_percent);
+            db.pushKV("bloombits", info.profile.bloom_bits);
+            db.pushKV("maxfilesize", info.profile.max_file_size_mb);
+            db.pushKV("usage", (uint64_t)info.memory_usage);
+            databases.push_back(db);
+        }
+        obj.pushKV("databases", databases);
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
@@ -1211,6 +1240,105 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
     }
 }
 
+static UniValue getperfstats(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"getperfstats",
+        "Returns timings of the most recent block connect, mempool accept, LLMQ processing and POVS stages.\n"
+        "Block template checks (getblocktemplate, mining) are reported under \"TestBlockValidity.*\", apart from \"ConnectBlock\".\n"
+        "Only the last " + ToString(tracespan::SPAN_BUFFER_SIZE) + " recorded spans are considered.\n",
+        {
+            {"format", RPCArg::Type::STR, /* default */ "\"summary\"", "determines what kind of information is returned.\n"
+    "  - \"summary\" returns per-stage percentiles in microseconds.\n"
+    "  - \"chrome\" returns the raw spans in Chrome trace event format (load it in chrome://tracing or Perfetto)."},
+        },
+        {
+            RPCResult{"format \"summary\"",
+                RPCResult::Type::OBJ_DYN, "", "",
+                {
+                    {RPCResult::Type::OBJ, "stage", "Timings of this stage",
+                    {
+                        {RPCResult::Type::NUM, "count", "Number of recorded spans"},
+                        {RPCResult::Type::NUM, "p50", "Median duration"},
+                        {RPCResult::Type::NUM, "p90", "90th percentile duration"},
+                        {RPCResult::Type::NUM, "p99", "99th percentile duration"},
+                        {RPCResult::Type::NUM, "max", "Maximum duration"},
+                        {RPCResult::Type::NUM, "total", "Sum of all durations"},
+                    }},
+                }
+            },
+            RPCResult{"format \"chrome\"",
+                RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::ARR, "traceEvents", "",
+                    {
+                        {RPCResult::Type::ELISION, "", ""},
+                    }},
+                }
+            },
+        },
+        RPCExamples{
+            HelpExampleCli("getperfstats", "")
+    + HelpExampleCli("getperfstats", "\"chrome\"")
+    + HelpExampleRpc("getperfstats", "")
+        },
+    }.Check(request);
+
+    const std::string format = request.params[0].isNull() ? "summary" : request.params[0].get_str();
+    if (format != "summary" && format != "chrome") {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "unknown format " + format);
+    }
+
+    const std::vector<tracespan::SpanEvent> spans = tracespan::GetRecentSpans();
+
+    if (format == "chrome") {
+        UniValue events(UniValue::VARR);
+        for (const auto& [tid, name] : tracespan::GetThreadNames()) {
+            UniValue meta(UniValue::VOBJ);
+            meta.pushKV("name", "thread_name");
+            meta.pushKV("ph", "M");
+            meta.pushKV("pid", 0);
+            meta.pushKV("tid", (uint64_t)tid);
+            UniValue args(UniValue::VOBJ);
+            args.pushKV("name", name);
+            meta.pushKV("args", args);
+            events.push_back(meta);
+        }
+        for (const auto& span : spans) {
+            UniValue event(UniValue::VOBJ);
+            event.pushKV("name", span.name);
+            event.pushKV("ph", "X");
+            event.pushKV("ts", span.start);
+            event.pushKV("dur", span.duration);
+            event.pushKV("pid", 0);
+            event.pushKV("tid", (uint64_t)span.thread);
+            events.push_back(event);
+        }
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("traceEvents", events);
+        return obj;
+    }
+
+    std::map<std::string, std::vector<int64_t>> durations;
+    for (const auto& span : spans) {
+        durations[span.name].push_back(span.duration);
+    }
+
+    UniValue obj(UniValue::VOBJ);
+    for (auto& [name, values] : durations) {
+        std::sort(values.begin(), values.end());
+        const auto percentile = [&values](size_t p) { return values[(values.size() - 1) * p / 100]; };
+        UniValue stage(UniValue::VOBJ);
+        stage.pushKV("count", (uint64_t)values.size());
+        stage.pushKV("p50", percentile(50));
+        stage.pushKV("p90", percentile(90));
+        stage.pushKV("p99", percentile(99));
+        stage.pushKV("max", values.back());
+        stage.pushKV("total", std::accumulate(values.begin(), values.end(), int64_t{0}));
+        obj.pushKV(name, stage);
+    }
+    return obj;
+}
+
 static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     cats = cats.get_array();
     for (unsigned int i = 0; i < cats.size(); ++i) {
@@ -1382,6 +1510,7 @@ static const CRPCCommand commands[] =
   //  --------------------- ------------------------  -----------------------  ----------
     { "control",            "debug",                  &debug,                  {} },
     { "control",            "getmemoryinfo",          &getmemoryinfo,          {"mode"} },
+    { "control",            "getperfstats",           &getperfstats,           {"format"} },
     { "control",            "logging",                &logging,                {"include", "exclude"}},
     { "util",               "validateaddress",        &validateaddress,        {"address"} },
     { "util",               "createmultisig",         &createmultisig,         {"nrequired","keys"} },
@@ -1390,14 +1519,14 @@ static const CRPCCommand commands[] =
     { "util",               "verifymessage",          &verifymessage,          {"address","signature","message"} },
     { "util",               "signmessagewithprivkey", &signmessagewithprivkey, {"privkey","message"} },
     { "util",               "getindexinfo",           &getindexinfo,           {"index_name"} },
-    { "blockchain",         "getspentinfo",           &getspentinfo,           {"json"} },
+    { "blockchain",         "getspentinfo",           &getspentinfo,           {"json"}, /*parallel_batch=*/true },
 
     /* Address index */
-    { "addressindex",       "getaddressmempool",      &getaddressmempool,      {"addresses"}  },
-    { "addressindex",       "getaddressutxos",        &getaddressutxos,        {"addresses"} },
-    { "addressindex",       "getaddressdeltas",       &getaddressdeltas,       {"addresses"} },
-    { "addressindex",       "getaddresstxids",        &getaddresstxids,        {"addresses"} },
-    { "addressindex",       "getaddressbalance",      &getaddressbalance,      {"addresses"} },
+    { "addressindex",       "getaddressmempool",      &getaddressmempool,      {"addresses"}, /*parallel_batch=*/true },
+    { "addressindex",       "getaddressutxos",        &getaddressutxos,        {"addresses"}, /*parallel_batch=*/true },
+    { "addressindex",       "getaddressdeltas",       &getaddressdeltas,       {"addresses"}, /*parallel_batch=*/true },
+    { "addressindex",       "getaddresstxids",        &getaddresstxids,        {"addresses"}, /*parallel_batch=*/true },
+    { "addressindex",       "getaddressbalance",      &getaddressbalance,      {"addresses"}, /*parallel_batch=*/true },
 
     /* BiblePay features */
     { "biblepay",               "mnsync",                 &mnsync,                 {} },
@@ -7,6 +7,8 @@
 #include <rpc/server.h>
 
 #include <chainparams.h>
+#include <ctpl_stl.h>
+#include <httpserver.h>
 #include <rpc/util.h>
 #include <shutdown.h>
 #include <sync.h>
@@ -21,12 +23,18 @@
 #include <cassert>
 #include <memory> // for unique_ptr
 #include <mutex>
+#include <set>
 #include <unordered_map>
 
 static Mutex g_rpc_warmup_mutex;
 static std::atomic<bool> g_rpc_running{false};
 static bool fRPCInWarmup GUARDED_BY(g_rpc_warmup_mutex) = true;
 static std::string rpcWarmupStatus GUARDED_BY(g_rpc_warmup_mutex) = "RPC server started";
+static Mutex g_rpc_batch_mutex;
+//! Executes the parallel elements of batch requests, created on first use
+static std::unique_ptr<ctpl::thread_pool> g_rpc_batch_workers GUARDED_BY(g_rpc_batch_mutex);
+static bool g_rpc_batch_stopped GUARDED_BY(g_rpc_batch_mutex){false};
+
 /* Timer-creating functions */
 static RPCTimerInterface* timerInterface = nullptr;
 /* Map of name to timer. */
@@ -344,6 +352,14 @@ void StopRPC()
     std::call_once(g_rpc_stop_flag, []() {
         LogPrint(BCLog::RPC, "Stopping RPC\n");
         WITH_LOCK(g_deadline_timers_mutex, deadlineTimers.clear());
+        std::unique_ptr<ctpl::thread_pool> batch_workers;
+        {
+            LOCK(g_rpc_batch_mutex);
+            g_rpc_batch_stopped = true;
+            batch_workers = std::move(g_rpc_batch_workers);
+        }
+        // runs everything which was queued already, so no batch is left waiting
+        if (batch_workers) batch_workers->stop(true);
         DeleteAuthCookie();
         g_rpcSignals.Stopped();
     });
@@ -410,13 +426,52 @@ static UniValue JSONRPCExecOne(JSONRPCRequest jreq, const UniValue& req)
     return rpc_result;
 }
 
+static bool IsParallelBatchRequest(const UniValue& req)
+{
+    if (!req.isObject()) return false;
+    const UniValue& method = find_value(req, "method");
+    return method.isStr() && tableRPC.IsParallelBatchMethod(method.get_str());
+}
+
 std::string JSONRPCExecBatch(const JSONRPCRequest& jreq, const UniValue& vReq)
 {
-    UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+    // Consecutive requests of parallel_batch methods are run on the batch workers, everything else is run in order
+    // on this thread after all previous requests are done. Replies are joined in request order into one string,
+    // which is sent after the last request is done.
+    // The queued tasks take copies of their requests, so they stay valid if this function unwinds early.
+    std::vector<std::future<UniValue>> pending;
+    std::string reply{"["};
+    size_t written{0};
+    auto append = [&](const UniValue& result) {
+        if (written++ > 0) reply += ',';
+        reply += result.write();
+    };
+    auto flush_pending = [&]() {
+        for (auto& f : pending) {
+            append(f.get());
+        }
+        pending.clear();
+    };
 
-    return ret.write() + "\n";
+    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++) {
+        const UniValue& req = vReq[reqIdx];
+        if (vReq.size() > 1 && IsParallelBatchRequest(req)) {
+            LOCK(g_rpc_batch_mutex);
+            if (!g_rpc_batch_stopped) {
+                if (!g_rpc_batch_workers) {
+                    g_rpc_batch_workers = std::make_unique<ctpl::thread_pool>(std::max<int>(gArgs.GetArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1));
+                    RenameThreadPool(*g_rpc_batch_workers, "rpc-batch");
+                }
+                pending.emplace_back(g_rpc_batch_workers->push([jreq, req](int) { return JSONRPCExecOne(jreq, req); }));
+                continue;
+            }
+        }
+        flush_pending();
+        append(JSONRPCExecOne(jreq, req));
+    }
+    flush_pending();
+
+    return reply + "]\n";
 }
 
 /**
@@ -602,6 +657,13 @@ std::vector<std::string> CRPCTable::listCommands() const
     return commandList;
 }
 
+bool CRPCTable::IsParallelBatchMethod(const std::string& name) const
+{
+    auto it = mapCommands.find(name);
+    if (it == mapCommands.end() || it->second.empty()) return false;
+    return std::all_of(it->second.begin(), it->second.end(), [](const CRPCCommand* command) { return command->parallel_batch; });
+}
+
 void RPCSetTimerInterfaceIfUnset(RPCTimerInterface *iface)
 {
     if (!timerInterface)
@@ -95,30 +95,31 @@ public:
     using Actor = std::function<bool(const JSONRPCRequest& request, UniValue& result, bool last_handler)>;
 
     //! Constructor taking Actor callback supporting multiple handlers.
-    CRPCCommand(std::string category, std::string name, Actor actor, std::vector<std::string> args, intptr_t unique_id)
+    CRPCCommand(std::string category, std::string name, Actor actor, std::vector<std::string> args, intptr_t unique_id, bool parallel_batch = false)
         : category(std::move(category)), name(std::move(name)), actor(std::move(actor)), argNames(std::move(args)),
-          unique_id(unique_id)
+          unique_id(unique_id), parallel_batch(parallel_batch)
     {
     }
 
     //! Simplified constructor taking plain RpcMethodFnType function pointer.
-    CRPCCommand(std::string category, std::string name_in, RpcMethodFnType fn, std::vector<std::string> args_in)
+    CRPCCommand(std::string category, std::string name_in, RpcMethodFnType fn, std::vector<std::string> args_in, bool parallel_batch = false)
         : CRPCCommand(
               category,
               fn().m_name,
               [fn](const JSONRPCRequest& request, UniValue& result, bool) { result = fn().HandleRequest(request); return true; },
               fn().GetArgNames(),
-              intptr_t(fn))
+              intptr_t(fn),
+              parallel_batch)
     {
         CHECK_NONFATAL(fn().m_name == name_in);
         CHECK_NONFATAL(fn().GetArgNames() == args_in);
     }
 
     //! Simplified constructor taking plain rpcfn_type function pointer.
-    CRPCCommand(const char* category, const char* name, rpcfn_type fn, std::initializer_list<const char*> args)
+    CRPCCommand(const char* category, const char* name, rpcfn_type fn, std::initializer_list<const char*> args, bool parallel_batch = false)
         : CRPCCommand(category, name,
                       [fn](const JSONRPCRequest& request, UniValue& result, bool) { result = fn(request); return true; },
-                      {args.begin(), args.end()}, intptr_t(fn))
+                      {args.begin(), args.end()}, intptr_t(fn), parallel_batch)
     {
     }
 
@@ -127,6 +128,8 @@ public:
     Actor actor;
     std::vector<std::string> argNames;
     intptr_t unique_id;
+    //! Read-only handler which may run concurrently with other elements of a batch request
+    bool parallel_batch;
 };
 
 /**
@@ -157,6 +160,12 @@ public:
     */
     std::vector<std::string> listCommands() const;
 
+    /**
+     * Returns whether all handlers of a method are flagged parallel_batch,
+     * so the method may run on the batch workers.
+     */
+    bool IsParallelBatchMethod(const std::string& name) const;
+
     /**
      * Appends a CRPCCommand to the dispatch table.
      *
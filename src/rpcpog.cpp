@@ -225,48 +225,13 @@ double StringToDouble(std::string s, int place)
 
 CBlockIndex* GetNextBlockIndex(CBlockIndex* pindex)
 {
-    CBlockIndex* next = g_chainman.ActiveChain().Tip()->GetAncestor(pindex->nHeight + 1);
-    if (next && next->pprev == pindex)
-    {
-        return next;
-    }
-    next = nullptr;
-    return next;
+    return g_chainman.ActiveChainSnapshot()->Next(pindex);
 }
 
-
-static CBlockIndex* pblockindexFBBHLast;
 CBlockIndex* FindBlockByHeight(int nHeight)
 {
-    CBlockIndex* pindexTip = WITH_LOCK(cs_main, return g_chainman.ActiveChain().Tip());
-    
-    CBlockIndex* pblockindex;
-    if (nHeight < 0 || nHeight > pindexTip->nHeight) return NULL;
-
-    if (nHeight < (pindexTip->nHeight / 2))
-    {
-        pblockindex = g_chainman.m_blockman.LookupBlockIndex(g_chainman.ActiveChain().Genesis()->GetBlockHash());
-    }
-    else
-    {
-        pblockindex = pindexTip;
-    }
-
-    if (pblockindexFBBHLast && abs(nHeight - pblockindex->nHeight) > abs(nHeight - pblockindexFBBHLast->nHeight))
-    {
-        pblockindex = pblockindexFBBHLast;
-    }
-
-    while (pblockindex->nHeight > nHeight)
-    {
-        pblockindex = pblockindex->pprev;
-    }
-    while (pblockindex->nHeight < nHeight)
-    {
-        pblockindex = GetNextBlockIndex(pblockindex);
-    }
-    pblockindexFBBHLast = pblockindex;
-    return pblockindex;
+    // The snapshot is read without cs_main, so callers can go on to read the block from disk without holding it either
+    return (*g_chainman.ActiveChainSnapshot())[nHeight];
 }
 
 std::string ReverseHex(std::string const& src)
@@ -527,6 +527,7 @@ bool ProcessTradingMessage(BBPTradingMessage bbptm);
 bool BBPTradingMessageSeen(std::string s);
 void SetBBPTradingMessageSeen(std::string s);
 AtomicTrade GetAtomicTradeFromTransaction(const CTransaction& tx);
+std::string GetSideChainPayloadFromTransaction(const CTransaction& tx);
 std::string AtomicCommunication(std::string Action, std::map<std::string, std::string> mapRequestHeaders);
 AtomicTrade TransmitAtomicTrade(JSONRPCRequest r, AtomicTrade a, std::string sMethod, std::string sAddressBookName);
 std::string YesNo(bool f); 
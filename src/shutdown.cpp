@@ -25,6 +25,8 @@ bool AbortNode(const std::string& strMessage, bilingual_str user_message)
 {
     SetMiscWarning(Untranslated(strMessage));
     LogPrintf("*** %s\n", strMessage);
+    // the file writer may not get to run again before the node goes down
+    LogInstance().FlushFileQueue();
     if (user_message.empty()) {
         user_message = _("A fatal internal error occurred, see debug.log for details");
     }
@@ -10,6 +10,7 @@
 
 #include <addressindex.h>
 #include <amount.h>
+#include <saltedhasher.h>
 #include <script/script.h>
 #include <serialize.h>
 #include <uint256.h>
@@ -39,6 +40,19 @@ public:
     {
         READWRITE(obj.m_tx_hash, obj.m_tx_index);
     }
+
+    friend bool operator==(const CSpentIndexKey& a, const CSpentIndexKey& b) {
+        return a.m_tx_hash == b.m_tx_hash && a.m_tx_index == b.m_tx_index;
+    }
+};
+
+template<>
+struct SaltedHasherImpl<CSpentIndexKey>
+{
+    static std::size_t CalcHash(const CSpentIndexKey& v, uint64_t k0, uint64_t k1)
+    {
+        return SipHashUint256Extra(k0, k1, v.m_tx_hash, v.m_tx_index);
+    }
 };
 
 struct CSpentIndexValue {
@@ -33,34 +33,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <compat.h>
 #include <netbase.h>
 #include <random.h>
+#include <util/strencodings.h>
 #include <util/system.h>
 
 #include <cmath>
 #include <cstdio>
+#include <map>
+#include <vector>
 
 statsd::StatsdClient statsClient;
 
 namespace statsd {
 
-inline bool fequal(float a, float b)
-{
-    const float epsilon = 0.0001;
-    return ( fabs(a - b) < epsilon );
-}
-
 thread_local FastRandomContext insecure_rand;
 
-inline bool should_send(float sample_rate)
-{
-    if ( fequal(sample_rate, 1.0) )
-    {
-        return true;
-    }
-
-    float p = float(insecure_rand(std::numeric_limits<uint32_t>::max())) / float(std::numeric_limits<uint32_t>::max());
-    return sample_rate > p;
-}
-
 struct _StatsdClientData {
     SOCKET  sock;
     struct  sockaddr_in server;
@@ -72,6 +58,29 @@ struct _StatsdClientData {
     bool    init;
 
     char    errmsg[1024];
+
+    //! -1 until -statsenabled has been read
+    std::atomic<int> enabled{-1};
+
+    struct Gauge {
+        double value{0};
+        bool fractional{false};
+    };
+    struct Timing {
+        uint64_t count{0};
+        uint64_t sum{0};
+        std::vector<size_t> samples;
+    };
+
+    Mutex cs_metrics;
+    //! recorded since the last flush
+    std::map<std::string, int64_t> counters GUARDED_BY(cs_metrics);
+    std::map<std::string, Gauge> gauges GUARDED_BY(cs_metrics);
+    std::map<std::string, Timing> timings GUARDED_BY(cs_metrics);
+    //! totals since startup, see prometheus()
+    std::map<std::string, int64_t> total_counters GUARDED_BY(cs_metrics);
+    std::map<std::string, Gauge> total_gauges GUARDED_BY(cs_metrics);
+    std::map<std::string, Timing> total_timings GUARDED_BY(cs_metrics);
 };
 
 StatsdClient::StatsdClient(const std::string& host, int port, const std::string& ns) :
@@ -89,6 +98,7 @@ StatsdClient::~StatsdClient()
 
 void StatsdClient::config(const std::string& host, int port, const std::string& ns)
 {
+    LOCK(cs_send);
     d->ns = ns;
     d->host = host;
     d->port = port;
@@ -96,14 +106,26 @@ void StatsdClient::config(const std::string& host, int port, const std::string&
     CloseSocket(d->sock);
 }
 
+bool StatsdClient::enabled()
+{
+    int fEnabled = d->enabled.load();
+    if (fEnabled < 0) {
+        fEnabled = gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE) ? 1 : 0;
+        d->enabled = fEnabled;
+    }
+    return fEnabled == 1;
+}
+
 int StatsdClient::init()
 {
-    static bool fEnabled = gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE);
-    if (!fEnabled) return -3;
+    if (!enabled()) return -3;
 
     if ( d->init ) return 0;
 
-    config(gArgs.GetArg("-statshost", DEFAULT_STATSD_HOST), gArgs.GetArg("-statsport", DEFAULT_STATSD_PORT), gArgs.GetArg("-statsns", DEFAULT_STATSD_NAMESPACE));
+    d->ns = gArgs.GetArg("-statsns", DEFAULT_STATSD_NAMESPACE);
+    d->host = gArgs.GetArg("-statshost", DEFAULT_STATSD_HOST);
+    d->port = gArgs.GetArg("-statsport", DEFAULT_STATSD_PORT);
+    CloseSocket(d->sock);
 
     d->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if ( d->sock == INVALID_SOCKET ) {
@@ -140,6 +162,16 @@ void StatsdClient::cleanup(std::string& key)
     }
 }
 
+std::string StatsdClient::formatKey(std::string key)
+{
+    // partition stats by node name if set
+    if (!d->nodename.empty())
+        key = key + "." + d->nodename;
+
+    cleanup(key);
+    return d->ns + key;
+}
+
 int StatsdClient::dec(const std::string& key, float sample_rate)
 {
     return count(key, -1, sample_rate);
@@ -172,59 +204,136 @@ int StatsdClient::timing(const std::string& key, size_t ms, float sample_rate)
 
 int StatsdClient::send(std::string key, size_t value, const std::string& type, float sample_rate)
 {
-    if (!should_send(sample_rate)) {
-        return 0;
-    }
-
-    // partition stats by node name if set
-    if (!d->nodename.empty())
-        key = key + "." + d->nodename;
+    return record(key, (ssize_t) value, type);
+}
 
-    cleanup(key);
+int StatsdClient::sendDouble(std::string key, double value, const std::string& type, float sample_rate)
+{
+    return record(key, value, type);
+}
 
-    char buf[256];
-    if ( fequal( sample_rate, 1.0 ) )
-    {
-        snprintf(buf, sizeof(buf), "%s%s:%zd|%s",
-                d->ns.c_str(), key.c_str(), (ssize_t) value, type.c_str());
+int StatsdClient::record(const std::string& key, double value, const std::string& type)
+{
+    if (!enabled()) return -3;
+
+    LOCK(d->cs_metrics);
+    if (type == "c") {
+        d->counters[key] += (int64_t) value;
+        d->total_counters[key] += (int64_t) value;
+    } else if (type == "g") {
+        const _StatsdClientData::Gauge gauge{value, value != std::floor(value)};
+        d->gauges[key] = gauge;
+        d->total_gauges[key] = gauge;
+    } else if (type == "ms") {
+        const size_t ms = (size_t) value;
+        auto& timing = d->timings[key];
+        ++timing.count;
+        if (timing.samples.size() < MAX_STATSD_TIMING_SAMPLES) {
+            timing.samples.push_back(ms);
+        } else {
+            // reservoir sampling keeps a uniform sample of this flush period
+            const uint64_t pos = insecure_rand.randrange(timing.count);
+            if (pos < MAX_STATSD_TIMING_SAMPLES) timing.samples[pos] = ms;
+        }
+        auto& total = d->total_timings[key];
+        ++total.count;
+        total.sum += ms;
     }
-    else
+    return 0;
+}
+
+void StatsdClient::flush()
+{
+    if (!enabled()) return;
+
+    decltype(d->counters) counters;
+    decltype(d->gauges) gauges;
+    decltype(d->timings) timings;
     {
-        snprintf(buf, sizeof(buf), "%s%s:%zd|%s|@%.2f",
-                d->ns.c_str(), key.c_str(), (ssize_t) value, type.c_str(), sample_rate);
+        LOCK(d->cs_metrics);
+        counters.swap(d->counters);
+        gauges.swap(d->gauges);
+        timings.swap(d->timings);
     }
 
-    return send(buf);
+    LOCK(cs_send);
+    if (init() != 0) return;
+
+    std::string packet;
+    const auto add_line = [&](const std::string& line) EXCLUSIVE_LOCKS_REQUIRED(cs_send) {
+        if (!packet.empty() && packet.size() + 1 + line.size() > MAX_STATSD_PACKET_SIZE) {
+            sendUnlocked(packet);
+            packet.clear();
+        }
+        if (!packet.empty()) packet += '\n';
+        packet += line;
+    };
+
+    for (const auto& [key, value] : counters) {
+        add_line(strprintf("%s:%d|c", formatKey(key), value));
+    }
+    for (const auto& [key, gauge] : gauges) {
+        if (gauge.fractional) {
+            add_line(strprintf("%s:%f|g", formatKey(key), gauge.value));
+        } else {
+            add_line(strprintf("%s:%d|g", formatKey(key), (int64_t) gauge.value));
+        }
+    }
+    for (const auto& [key, timing] : timings) {
+        const std::string name = formatKey(key);
+        // let statsd scale the sample back up if samples were dropped
+        const std::string rate = timing.samples.size() < timing.count ?
+            strprintf("|@%.4f", (double) timing.samples.size() / timing.count) : "";
+        for (const size_t ms : timing.samples) {
+            add_line(strprintf("%s:%d|ms%s", name, ms, rate));
+        }
+    }
+    if (!packet.empty()) sendUnlocked(packet);
 }
 
-int StatsdClient::sendDouble(std::string key, double value, const std::string& type, float sample_rate)
+static std::string PrometheusName(const std::string& key)
 {
-    if (!should_send(sample_rate)) {
-        return 0;
+    std::string name;
+    name.reserve(key.size() + 1);
+    for (const char c : key) {
+        name += IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ? c : '_';
     }
+    if (name.empty() || IsDigit(name[0])) name.insert(0, "_");
+    return name;
+}
 
-    // partition stats by node name if set
-    if (!d->nodename.empty())
-        key = key + "." + d->nodename;
-
-    cleanup(key);
-
-    char buf[256];
-    if ( fequal( sample_rate, 1.0 ) )
-    {
-        snprintf(buf, sizeof(buf), "%s%s:%f|%s",
-                d->ns.c_str(), key.c_str(), value, type.c_str());
-    }
-    else
+std::string StatsdClient::prometheus()
+{
+    std::string ns;
     {
-        snprintf(buf, sizeof(buf), "%s%s:%f|%s|@%.2f",
-                d->ns.c_str(), key.c_str(), value, type.c_str(), sample_rate);
+        LOCK(cs_send);
+        ns = d->ns;
     }
 
-    return send(buf);
+    std::string ret;
+    LOCK(d->cs_metrics);
+    for (const auto& [key, value] : d->total_counters) {
+        const std::string name = PrometheusName(ns + key);
+        ret += strprintf("# TYPE %s counter\n%s %d\n", name, name, value);
+    }
+    for (const auto& [key, gauge] : d->total_gauges) {
+        const std::string name = PrometheusName(ns + key);
+        ret += strprintf("# TYPE %s gauge\n%s %s\n", name, name, gauge.fractional ? strprintf("%f", gauge.value) : strprintf("%d", (int64_t) gauge.value));
+    }
+    for (const auto& [key, timing] : d->total_timings) {
+        const std::string name = PrometheusName(ns + key);
+        ret += strprintf("# TYPE %s summary\n%s_sum %d\n%s_count %d\n", name, name, timing.sum, name, timing.count);
+    }
+    return ret;
 }
 
 int StatsdClient::send(const std::string& message)
+{
+    LOCK(cs_send);
+    return sendUnlocked(message);
+}
+
+int StatsdClient::sendUnlocked(const std::string& message)
 {
     int ret = init();
     if ( ret )
@@ -5,6 +5,8 @@
 #ifndef BITCOIN_STATSD_CLIENT_H
 #define BITCOIN_STATSD_CLIENT_H
 
+#include <sync.h>
+
 #include <string>
 #include <memory>
 
@@ -19,6 +21,13 @@ static const int DEFAULT_STATSD_PERIOD = 60;
 static const int MIN_STATSD_PERIOD = 5;
 static const int MAX_STATSD_PERIOD = 60 * 60;
 
+// metrics are aggregated in-process and sent to statsd every STATSD_FLUSH_PERIOD seconds
+static const int STATSD_FLUSH_PERIOD = 1;
+// lines are batched into packets of at most this size (fits a typical ethernet MTU)
+static const size_t MAX_STATSD_PACKET_SIZE = 1432;
+// timing samples kept per key between flushes, further samples are reservoir sampled
+static const size_t MAX_STATSD_TIMING_SAMPLES = 1000;
+
 namespace statsd {
 
 struct _StatsdClientData;
@@ -34,6 +43,11 @@ class StatsdClient {
         const char* errmsg();
 
     public:
+        /**
+         * Metrics are aggregated in-process and only sent by flush(), so
+         * recording costs no syscall. Every call is recorded; sample_rate
+         * is kept for compatibility.
+         */
         int inc(const std::string& key, float sample_rate = 1.0);
         int dec(const std::string& key, float sample_rate = 1.0);
         int count(const std::string& key, size_t value, float sample_rate = 1.0);
@@ -41,6 +55,16 @@ class StatsdClient {
         int gaugeDouble(const std::string& key, double value, float sample_rate = 1.0);
         int timing(const std::string& key, size_t ms, float sample_rate = 1.0);
 
+    public:
+        /** Send everything recorded since the last flush as batched statsd packets */
+        void flush();
+
+        /** Totals since startup in the Prometheus text exposition format */
+        std::string prometheus();
+
+        /** Whether -statsenabled is set; metrics are not recorded otherwise */
+        bool enabled();
+
     public:
         /**
          * (Low Level Api) manually send a message
@@ -57,10 +81,15 @@ class StatsdClient {
                 const std::string& type, float sample_rate);
 
     protected:
-        int init();
+        int init() EXCLUSIVE_LOCKS_REQUIRED(cs_send);
+        std::string formatKey(std::string key) EXCLUSIVE_LOCKS_REQUIRED(cs_send);
+        int sendUnlocked(const std::string& message) EXCLUSIVE_LOCKS_REQUIRED(cs_send);
+        int record(const std::string& key, double value, const std::string& type);
         static void cleanup(std::string& key);
 
     protected:
+        //! guards the socket and the connection settings in d
+        Mutex cs_send;
         std::unique_ptr<struct _StatsdClientData> d;
 };
 
@@ -0,0 +1,129 @@
+// Copyright (c) 2024 The BiblePay Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <flatfile.h>
+#include <node/blockcompression.h>
+#include <node/blockstorage.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(blockcompression_tests, BasicTestingSetup)
+
+static std::vector<uint8_t> ToBytes(const std::string& str)
+{
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+static std::string GSCRows(int count)
+{
+    std::string rows;
+    for (int i = 0; i < count; ++i) {
+        rows += "<row><col>B" + ToString(i * 7919) + "</col><col>" + ToString(i % 97) + ".25</col></row>";
+    }
+    return rows;
+}
+
+BOOST_AUTO_TEST_CASE(compression_roundtrip)
+{
+    std::vector<std::vector<uint8_t>> inputs{
+        {},
+        {0x42},
+        std::vector<uint8_t>(100000, 0),
+        ToBytes("<VER>v1.0.0.1</VER><SANC></SANC>"),
+        ToBytes(GSCRows(1000)),
+        g_insecure_rand_ctx.randbytes(50000),
+    };
+    for (const auto& input : inputs) {
+        const std::vector<uint8_t> compressed{CompressBlockData(input)};
+        std::vector<uint8_t> output{1, 2, 3};
+        BOOST_REQUIRE(DecompressBlockData(compressed, output, MAX_SIZE));
+        BOOST_CHECK(output == input);
+    }
+
+    // The XML vocabulary of BiblePay payloads compresses well
+    const std::vector<uint8_t> rows{ToBytes(GSCRows(1000))};
+    BOOST_CHECK_LT(CompressBlockData(rows).size() * 2, rows.size());
+}
+
+BOOST_AUTO_TEST_CASE(compression_corrupt)
+{
+    const std::vector<uint8_t> input{ToBytes(GSCRows(100))};
+    const std::vector<uint8_t> compressed{CompressBlockData(input)};
+    std::vector<uint8_t> output;
+
+    // Too large for the caller's limit
+    BOOST_CHECK(!DecompressBlockData(compressed, output, input.size() - 1));
+    BOOST_CHECK(DecompressBlockData(compressed, output, input.size()));
+
+    // Unknown dictionary
+    std::vector<uint8_t> bad{compressed};
+    bad[0] = 0xff;
+    BOOST_CHECK(!DecompressBlockData(bad, output, MAX_SIZE));
+
+    // Truncated data never decodes
+    for (size_t len = 0; len < compressed.size(); ++len) {
+        BOOST_CHECK(!DecompressBlockData(Span{compressed}.first(len), output, MAX_SIZE));
+    }
+
+    // Flipped bits must not make the decoder read or write out of bounds
+    for (int i = 0; i < 1000; ++i) {
+        bad = compressed;
+        bad[1 + g_insecure_rand_ctx.randrange(bad.size() - 1)] ^= 1 << g_insecure_rand_ctx.randrange(8);
+        if (DecompressBlockData(bad, output, MAX_SIZE)) {
+            BOOST_CHECK_EQUAL(output.size(), ReadLE32(bad.data() + 1));
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(compressed_block_storage, TestingSetup)
+{
+    // A block carrying GSC style payloads in its outputs
+    CBlock block{Params().GenesisBlock()};
+    CMutableTransaction mtx;
+    mtx.vin.resize(1);
+    for (int i = 0; i < 10; ++i) {
+        CTxOut out;
+        out.nValue = i;
+        out.sTxOutMessage = GSCRows(30);
+        mtx.vout.push_back(out);
+    }
+    block.vtx.push_back(MakeTransactionRef(mtx));
+    std::vector<uint8_t> expected;
+    CVectorWriter{SER_NETWORK, PROTOCOL_VERSION, expected, 0, block};
+
+    for (const bool compression : {false, true}) {
+        fBlockCompression = compression;
+        const FlatFilePos pos{WITH_LOCK(cs_main, return SaveBlockToDisk(block, 1, m_node.chainman->ActiveChain(), Params(), nullptr))};
+        fBlockCompression = DEFAULT_BLOCK_COMPRESSION;
+        BOOST_REQUIRE(!pos.IsNull());
+
+        // The record header tells which format the payload is in
+        FlatFilePos size_pos{pos};
+        size_pos.nPos -= 4;
+        CAutoFile file(OpenBlockFile(size_pos, true), SER_DISK, CLIENT_VERSION);
+        uint32_t record_size;
+        file >> record_size;
+        BOOST_CHECK_EQUAL((record_size & BLOCK_RECORD_COMPRESSED) != 0, compression);
+        BOOST_CHECK_EQUAL((record_size & ~BLOCK_RECORD_COMPRESSED) < expected.size() / 2, compression);
+        bool compressed{!compression};
+        std::vector<uint8_t> data;
+        BOOST_CHECK(CAutoFile(OpenBlockRecord(pos, compressed, data), SER_DISK, CLIENT_VERSION).Get() != nullptr);
+        BOOST_CHECK_EQUAL(compressed, compression);
+        BOOST_CHECK(compressed ? data == expected : data.empty());
+
+        // Readers always get the network format back
+        std::vector<uint8_t> raw;
+        BOOST_REQUIRE(ReadRawBlockFromDisk(raw, pos, Params().MessageStart()));
+        BOOST_CHECK(raw == expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
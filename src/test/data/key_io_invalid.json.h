@@ -0,0 +1,530 @@
+namespace json_tests{
+static unsigned const char key_io_invalid[] = {
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x78, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x38, 0x32, 0x31, 0x32, 0x61, 0x62, 
+0x64, 0x38, 0x72, 0x72, 0x7a, 0x63, 0x4a, 0x6d, 
+0x42, 0x47, 0x39, 0x6e, 0x37, 0x56, 0x6d, 0x53, 
+0x70, 0x61, 0x4d, 0x66, 0x50, 0x52, 0x58, 0x68, 
+0x79, 0x48, 0x6b, 0x51, 0x74, 0x4e, 0x58, 0x46, 
+0x41, 0x4d, 0x50, 0x43, 0x55, 0x71, 0x51, 0x54, 
+0x46, 0x39, 0x4b, 0x6d, 0x73, 0x6b, 0x35, 0x56, 
+0x46, 0x33, 0x62, 0x38, 0x31, 0x78, 0x31, 0x71, 
+0x74, 0x39, 0x74, 0x52, 0x73, 0x51, 0x32, 0x52, 
+0x45, 0x4b, 0x51, 0x36, 0x6a, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x35, 0x43, 0x50, 
+0x59, 0x43, 0x69, 0x52, 0x6b, 0x37, 0x4c, 0x6a, 
+0x69, 0x59, 0x51, 0x63, 0x34, 0x35, 0x47, 0x51, 
+0x54, 0x67, 0x71, 0x4e, 0x6a, 0x59, 0x77, 0x35, 
+0x74, 0x57, 0x65, 0x43, 0x5a, 0x64, 0x31, 0x4e, 
+0x57, 0x76, 0x65, 0x76, 0x66, 0x36, 0x53, 0x51, 
+0x66, 0x4a, 0x76, 0x44, 0x6d, 0x39, 0x76, 0x4b, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x55, 0x42, 0x38, 0x59, 0x6b, 0x4c, 0x41, 
+0x73, 0x6f, 0x4a, 0x57, 0x45, 0x73, 0x77, 0x36, 
+0x64, 0x61, 0x78, 0x4b, 0x76, 0x6f, 0x35, 0x57, 
+0x34, 0x4e, 0x56, 0x6a, 0x4c, 0x53, 0x42, 0x38, 
+0x42, 0x73, 0x6b, 0x6f, 0x36, 0x55, 0x43, 0x57, 
+0x4d, 0x72, 0x4c, 0x6e, 0x6f, 0x46, 0x4b, 0x67, 
+0x45, 0x54, 0x58, 0x64, 0x4b, 0x61, 0x32, 0x58, 
+0x63, 0x76, 0x6f, 0x57, 0x64, 0x6a, 0x65, 0x65, 
+0x4c, 0x62, 0x4b, 0x71, 0x52, 0x63, 0x61, 0x57, 
+0x77, 0x47, 0x76, 0x71, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x39, 0x73, 0x57, 0x39, 
+0x76, 0x6e, 0x62, 0x4c, 0x48, 0x66, 0x64, 0x63, 
+0x71, 0x68, 0x55, 0x32, 0x6e, 0x35, 0x62, 0x4c, 
+0x41, 0x46, 0x55, 0x6b, 0x73, 0x53, 0x67, 0x43, 
+0x69, 0x4d, 0x42, 0x56, 0x6d, 0x64, 0x6e, 0x36, 
+0x50, 0x61, 0x65, 0x33, 0x69, 0x54, 0x59, 0x6f, 
+0x34, 0x39, 0x61, 0x53, 0x71, 0x5a, 0x65, 0x53, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x46, 0x65, 0x4c, 0x54, 0x38, 0x67, 0x37, 
+0x71, 0x32, 0x35, 0x63, 0x76, 0x56, 0x6d, 0x55, 
+0x6a, 0x51, 0x6e, 0x58, 0x76, 0x54, 0x74, 0x37, 
+0x72, 0x70, 0x57, 0x44, 0x74, 0x52, 0x6a, 0x71, 
+0x32, 0x6f, 0x69, 0x39, 0x46, 0x39, 0x7a, 0x6a, 
+0x33, 0x72, 0x4c, 0x57, 0x78, 0x4e, 0x4b, 0x53, 
+0x6f, 0x4b, 0x63, 0x50, 0x4c, 0x6f, 0x62, 0x36, 
+0x54, 0x45, 0x42, 0x32, 0x52, 0x41, 0x65, 0x75, 
+0x6d, 0x61, 0x75, 0x52, 0x7a, 0x6a, 0x35, 0x45, 
+0x6d, 0x35, 0x75, 0x4c, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x37, 0x56, 0x62, 0x67, 
+0x33, 0x52, 0x45, 0x75, 0x73, 0x4e, 0x36, 0x74, 
+0x61, 0x67, 0x4c, 0x77, 0x48, 0x6b, 0x7a, 0x34, 
+0x50, 0x37, 0x31, 0x56, 0x5a, 0x74, 0x70, 0x38, 
+0x6f, 0x54, 0x54, 0x74, 0x45, 0x54, 0x6d, 0x61, 
+0x54, 0x46, 0x4a, 0x66, 0x79, 0x70, 0x64, 0x58, 
+0x34, 0x4a, 0x37, 0x76, 0x42, 0x6d, 0x70, 0x36, 
+0x43, 0x4d, 0x7a, 0x57, 0x70, 0x4e, 0x56, 0x33, 
+0x52, 0x55, 0x64, 0x76, 0x37, 0x54, 0x53, 0x54, 
+0x32, 0x6e, 0x69, 0x67, 0x55, 0x7a, 0x32, 0x6f, 
+0x55, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x37, 0x6f, 0x62, 0x4b, 0x36, 0x44, 0x68, 
+0x75, 0x63, 0x45, 0x75, 0x76, 0x43, 0x69, 0x6e, 
+0x4b, 0x4c, 0x41, 0x55, 0x4e, 0x59, 0x4d, 0x50, 
+0x58, 0x4e, 0x45, 0x46, 0x43, 0x48, 0x63, 0x45, 
+0x72, 0x58, 0x61, 0x36, 0x31, 0x77, 0x69, 0x32, 
+0x73, 0x4d, 0x69, 0x36, 0x36, 0x6f, 0x77, 0x69, 
+0x6e, 0x4d, 0x34, 0x45, 0x38, 0x59, 0x44, 0x34, 
+0x72, 0x6b, 0x67, 0x48, 0x56, 0x76, 0x78, 0x70, 
+0x76, 0x33, 0x5a, 0x47, 0x78, 0x46, 0x4e, 0x58, 
+0x55, 0x79, 0x43, 0x41, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x33, 0x46, 0x50, 0x65, 
+0x32, 0x38, 0x64, 0x78, 0x4a, 0x44, 0x68, 0x45, 
+0x6d, 0x6b, 0x41, 0x62, 0x47, 0x56, 0x67, 0x73, 
+0x54, 0x35, 0x58, 0x46, 0x70, 0x42, 0x77, 0x79, 
+0x4d, 0x34, 0x38, 0x46, 0x4b, 0x34, 0x76, 0x65, 
+0x79, 0x69, 0x51, 0x56, 0x67, 0x41, 0x4b, 0x76, 
+0x51, 0x4c, 0x54, 0x65, 0x61, 0x32, 0x55, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 
+0x55, 0x4c, 0x55, 0x33, 0x50, 0x42, 0x37, 0x75, 
+0x33, 0x72, 0x78, 0x66, 0x55, 0x58, 0x4b, 0x56, 
+0x62, 0x35, 0x6d, 0x5a, 0x34, 0x69, 0x6a, 0x58, 
+0x62, 0x6a, 0x38, 0x35, 0x4c, 0x4e, 0x39, 0x39, 
+0x73, 0x37, 0x7a, 0x65, 0x73, 0x73, 0x35, 0x58, 
+0x50, 0x5a, 0x45, 0x58, 0x31, 0x44, 0x4a, 0x76, 
+0x61, 0x6e, 0x48, 0x6f, 0x59, 0x36, 0x64, 0x4c, 
+0x76, 0x59, 0x6e, 0x6b, 0x4c, 0x74, 0x51, 0x44, 
+0x57, 0x51, 0x32, 0x71, 0x43, 0x71, 0x31, 0x47, 
+0x57, 0x53, 0x41, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x37, 0x56, 0x42, 0x6d, 0x50, 
+0x6d, 0x4a, 0x4d, 0x55, 0x46, 0x77, 0x59, 0x68, 
+0x67, 0x6b, 0x74, 0x69, 0x76, 0x76, 0x71, 0x42, 
+0x5a, 0x63, 0x50, 0x7a, 0x71, 0x64, 0x4b, 0x50, 
+0x79, 0x34, 0x53, 0x34, 0x52, 0x52, 0x54, 0x41, 
+0x43, 0x64, 0x77, 0x54, 0x69, 0x56, 0x36, 0x77, 
+0x4e, 0x70, 0x6b, 0x70, 0x58, 0x45, 0x6d, 0x70, 
+0x33, 0x74, 0x76, 0x44, 0x68, 0x7a, 0x6b, 0x71, 
+0x64, 0x79, 0x46, 0x68, 0x58, 0x64, 0x4a, 0x38, 
+0x38, 0x51, 0x35, 0x54, 0x39, 0x6d, 0x6b, 0x61, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x5a, 0x78, 0x31, 0x47, 0x35, 0x43, 0x4d, 
+0x72, 0x45, 0x43, 0x34, 0x59, 0x38, 0x45, 0x42, 
+0x56, 0x78, 0x76, 0x65, 0x70, 0x6d, 0x4d, 0x31, 
+0x61, 0x69, 0x58, 0x76, 0x37, 0x43, 0x65, 0x6e, 
+0x71, 0x55, 0x52, 0x31, 0x64, 0x5a, 0x42, 0x78, 
+0x43, 0x34, 0x50, 0x46, 0x55, 0x76, 0x39, 0x6a, 
+0x41, 0x41, 0x6d, 0x38, 0x54, 0x55, 0x78, 0x44, 
+0x34, 0x53, 0x4b, 0x43, 0x32, 0x41, 0x72, 0x77, 
+0x4b, 0x61, 0x77, 0x41, 0x33, 0x59, 0x34, 0x72, 
+0x68, 0x43, 0x32, 0x76, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x79, 0x61, 0x57, 0x5a, 
+0x6d, 0x65, 0x71, 0x57, 0x72, 0x35, 0x4d, 0x65, 
+0x61, 0x36, 0x32, 0x45, 0x43, 0x6f, 0x4d, 0x50, 
+0x7a, 0x56, 0x6b, 0x58, 0x78, 0x48, 0x47, 0x44, 
+0x46, 0x36, 0x4c, 0x74, 0x43, 0x66, 0x63, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x37, 
+0x56, 0x50, 0x73, 0x33, 0x36, 0x57, 0x47, 0x63, 
+0x62, 0x64, 0x46, 0x73, 0x43, 0x42, 0x73, 0x4d, 
+0x58, 0x45, 0x78, 0x67, 0x42, 0x6f, 0x4d, 0x65, 
+0x6d, 0x65, 0x38, 0x54, 0x37, 0x65, 0x4a, 0x34, 
+0x67, 0x33, 0x55, 0x4d, 0x71, 0x51, 0x72, 0x68, 
+0x72, 0x41, 0x32, 0x4c, 0x79, 0x79, 0x73, 0x35, 
+0x76, 0x69, 0x33, 0x64, 0x67, 0x48, 0x34, 0x33, 
+0x6e, 0x62, 0x7a, 0x31, 0x41, 0x56, 0x34, 0x59, 
+0x46, 0x7a, 0x33, 0x5a, 0x52, 0x4b, 0x4c, 0x64, 
+0x46, 0x73, 0x6e, 0x75, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x32, 0x44, 0x53, 0x35, 
+0x4c, 0x54, 0x72, 0x33, 0x41, 0x67, 0x72, 0x54, 
+0x47, 0x6f, 0x42, 0x44, 0x33, 0x6e, 0x71, 0x58, 
+0x57, 0x44, 0x50, 0x74, 0x43, 0x4d, 0x64, 0x39, 
+0x38, 0x6d, 0x6b, 0x6f, 0x70, 0x34, 0x77, 0x78, 
+0x61, 0x56, 0x66, 0x52, 0x57, 0x77, 0x50, 0x46, 
+0x59, 0x76, 0x6d, 0x70, 0x58, 0x50, 0x35, 0x68, 
+0x47, 0x35, 0x62, 0x4b, 0x7a, 0x56, 0x56, 0x7a, 
+0x76, 0x73, 0x4b, 0x7a, 0x50, 0x38, 0x39, 0x54, 
+0x48, 0x69, 0x69, 0x52, 0x64, 0x33, 0x50, 0x72, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x44, 0x65, 0x52, 0x58, 0x79, 0x62, 0x63, 0x5a, 
+0x76, 0x65, 0x38, 0x36, 0x58, 0x58, 0x61, 0x6e, 
+0x76, 0x6d, 0x4c, 0x47, 0x39, 0x58, 0x77, 0x46, 
+0x61, 0x64, 0x45, 0x68, 0x38, 0x47, 0x6a, 0x48, 
+0x32, 0x59, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x37, 0x70, 0x65, 0x6a, 0x6e, 0x57, 
+0x77, 0x31, 0x71, 0x48, 0x6a, 0x43, 0x66, 0x41, 
+0x6d, 0x7a, 0x58, 0x6f, 0x53, 0x74, 0x78, 0x46, 
+0x5a, 0x59, 0x4d, 0x4a, 0x36, 0x68, 0x75, 0x31, 
+0x67, 0x69, 0x78, 0x6f, 0x4a, 0x44, 0x38, 0x69, 
+0x72, 0x74, 0x79, 0x72, 0x6b, 0x69, 0x35, 0x41, 
+0x39, 0x50, 0x48, 0x44, 0x57, 0x56, 0x37, 0x39, 
+0x38, 0x59, 0x4d, 0x61, 0x48, 0x33, 0x74, 0x65, 
+0x42, 0x61, 0x64, 0x79, 0x61, 0x74, 0x6d, 0x64, 
+0x56, 0x32, 0x59, 0x76, 0x54, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x34, 0x59, 0x69, 
+0x32, 0x79, 0x42, 0x6f, 0x6b, 0x63, 0x41, 0x6a, 
+0x36, 0x61, 0x63, 0x4c, 0x5a, 0x68, 0x69, 0x4e, 
+0x77, 0x6d, 0x6d, 0x41, 0x31, 0x44, 0x53, 0x7a, 
+0x75, 0x4b, 0x6e, 0x7a, 0x38, 0x76, 0x66, 0x4a, 
+0x31, 0x46, 0x48, 0x45, 0x32, 0x79, 0x4a, 0x4c, 
+0x53, 0x54, 0x61, 0x62, 0x36, 0x46, 0x55, 0x69, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x55, 0x36, 0x35, 0x46, 0x36, 0x4a, 0x54, 
+0x78, 0x44, 0x50, 0x32, 0x59, 0x4a, 0x35, 0x58, 
+0x56, 0x36, 0x46, 0x69, 0x59, 0x78, 0x70, 0x57, 
+0x4d, 0x43, 0x6a, 0x77, 0x43, 0x52, 0x62, 0x45, 
+0x4e, 0x39, 0x79, 0x67, 0x45, 0x58, 0x5a, 0x33, 
+0x4b, 0x6b, 0x62, 0x4c, 0x55, 0x4d, 0x6a, 0x53, 
+0x62, 0x76, 0x4b, 0x62, 0x50, 0x79, 0x43, 0x4d, 
+0x4c, 0x66, 0x36, 0x6b, 0x65, 0x39, 0x6b, 0x4d, 
+0x50, 0x67, 0x39, 0x43, 0x4c, 0x51, 0x63, 0x4a, 
+0x37, 0x61, 0x4e, 0x39, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x37, 0x55, 0x67, 0x4e, 
+0x4e, 0x45, 0x41, 0x66, 0x64, 0x69, 0x6e, 0x78, 
+0x44, 0x47, 0x33, 0x38, 0x42, 0x79, 0x47, 0x6d, 
+0x56, 0x77, 0x62, 0x52, 0x4a, 0x70, 0x37, 0x62, 
+0x34, 0x71, 0x38, 0x42, 0x45, 0x7a, 0x6e, 0x6d, 
+0x32, 0x47, 0x58, 0x62, 0x53, 0x4a, 0x46, 0x56, 
+0x53, 0x54, 0x79, 0x53, 0x33, 0x6a, 0x69, 0x42, 
+0x79, 0x4e, 0x4c, 0x55, 0x38, 0x63, 0x6b, 0x44, 
+0x70, 0x72, 0x59, 0x6b, 0x71, 0x76, 0x69, 0x35, 
+0x62, 0x63, 0x66, 0x36, 0x31, 0x53, 0x55, 0x6b, 
+0x77, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x36, 0x77, 0x7a, 0x4d, 0x69, 0x66, 0x38, 
+0x54, 0x52, 0x7a, 0x72, 0x6e, 0x79, 0x51, 0x59, 
+0x41, 0x62, 0x52, 0x5a, 0x53, 0x68, 0x57, 0x63, 
+0x5a, 0x6f, 0x33, 0x64, 0x71, 0x4b, 0x59, 0x6b, 
+0x42, 0x56, 0x70, 0x69, 0x32, 0x4a, 0x52, 0x31, 
+0x35, 0x44, 0x46, 0x4d, 0x43, 0x4c, 0x7a, 0x78, 
+0x41, 0x6b, 0x56, 0x54, 0x55, 0x70, 0x73, 0x75, 
+0x77, 0x64, 0x54, 0x55, 0x57, 0x6e, 0x6b, 0x78, 
+0x39, 0x6a, 0x31, 0x6b, 0x47, 0x44, 0x79, 0x75, 
+0x6b, 0x68, 0x31, 0x47, 0x6f, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x36, 0x59, 0x4b, 
+0x5a, 0x66, 0x67, 0x59, 0x4a, 0x53, 0x68, 0x39, 
+0x69, 0x76, 0x7a, 0x46, 0x58, 0x31, 0x6f, 0x4e, 
+0x71, 0x54, 0x69, 0x69, 0x57, 0x77, 0x68, 0x43, 
+0x47, 0x72, 0x5a, 0x62, 0x6e, 0x44, 0x43, 0x69, 
+0x67, 0x55, 0x36, 0x4e, 0x35, 0x6f, 0x79, 0x69, 
+0x42, 0x65, 0x56, 0x55, 0x4b, 0x69, 0x6f, 0x35, 
+0x77, 0x77, 0x33, 0x5a, 0x75, 0x34, 0x4e, 0x36, 
+0x4b, 0x36, 0x4e, 0x48, 0x73, 0x71, 0x61, 0x52, 
+0x38, 0x64, 0x6a, 0x53, 0x68, 0x39, 0x64, 0x4c, 
+0x66, 0x58, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x39, 0x32, 0x73, 0x57, 0x4b, 0x37, 
+0x51, 0x65, 0x73, 0x41, 0x50, 0x57, 0x53, 0x31, 
+0x32, 0x73, 0x72, 0x69, 0x73, 0x48, 0x6d, 0x63, 
+0x39, 0x71, 0x38, 0x46, 0x7a, 0x38, 0x5a, 0x35, 
+0x45, 0x52, 0x4a, 0x63, 0x41, 0x61, 0x56, 0x77, 
+0x6b, 0x6a, 0x56, 0x4b, 0x45, 0x4e, 0x4a, 0x6d, 
+0x4c, 0x34, 0x35, 0x62, 0x42, 0x4d, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 0x55, 
+0x61, 0x38, 0x68, 0x65, 0x65, 0x59, 0x43, 0x54, 
+0x54, 0x73, 0x72, 0x35, 0x71, 0x67, 0x69, 0x37, 
+0x76, 0x6f, 0x72, 0x54, 0x70, 0x44, 0x41, 0x57, 
+0x56, 0x52, 0x47, 0x52, 0x41, 0x4a, 0x4b, 0x5a, 
+0x37, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x32, 0x41, 0x36, 0x42, 0x76, 0x76, 0x6d, 
+0x5a, 0x38, 0x36, 0x47, 0x47, 0x37, 0x54, 0x52, 
+0x77, 0x58, 0x79, 0x43, 0x61, 0x43, 0x76, 0x68, 
+0x69, 0x4d, 0x35, 0x46, 0x73, 0x56, 0x46, 0x76, 
+0x73, 0x34, 0x32, 0x78, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x52, 0x35, 0x75, 0x69, 
+0x42, 0x71, 0x32, 0x72, 0x7a, 0x56, 0x47, 0x68, 
+0x78, 0x44, 0x73, 0x71, 0x33, 0x4d, 0x65, 0x47, 
+0x55, 0x33, 0x51, 0x4b, 0x65, 0x5a, 0x7a, 0x38, 
+0x77, 0x4c, 0x79, 0x77, 0x61, 0x42, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 0x37, 
+0x39, 0x41, 0x63, 0x42, 0x4d, 0x44, 0x57, 0x78, 
+0x68, 0x35, 0x68, 0x6e, 0x66, 0x45, 0x6d, 0x35, 
+0x6b, 0x70, 0x74, 0x77, 0x6e, 0x66, 0x6e, 0x37, 
+0x72, 0x45, 0x57, 0x73, 0x63, 0x68, 0x68, 0x64, 
+0x78, 0x6b, 0x45, 0x7a, 0x4c, 0x59, 0x7a, 0x45, 
+0x6a, 0x32, 0x4b, 0x33, 0x77, 0x53, 0x48, 0x66, 
+0x45, 0x61, 0x71, 0x56, 0x32, 0x6d, 0x6f, 0x65, 
+0x63, 0x36, 0x77, 0x50, 0x35, 0x77, 0x33, 0x6a, 
+0x56, 0x79, 0x35, 0x63, 0x46, 0x68, 0x6f, 0x56, 
+0x58, 0x6b, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x37, 0x56, 0x4d, 0x52, 0x73, 0x50, 
+0x56, 0x77, 0x6f, 0x6a, 0x37, 0x76, 0x5a, 0x41, 
+0x54, 0x4b, 0x51, 0x47, 0x6a, 0x32, 0x79, 0x56, 
+0x45, 0x58, 0x35, 0x35, 0x66, 0x32, 0x71, 0x4e, 
+0x4b, 0x44, 0x78, 0x4e, 0x69, 0x77, 0x37, 0x59, 
+0x4e, 0x4a, 0x76, 0x31, 0x7a, 0x6a, 0x66, 0x46, 
+0x46, 0x7a, 0x79, 0x57, 0x52, 0x31, 0x57, 0x53, 
+0x36, 0x37, 0x74, 0x65, 0x66, 0x70, 0x37, 0x66, 
+0x56, 0x31, 0x4d, 0x70, 0x58, 0x72, 0x55, 0x68, 
+0x4e, 0x68, 0x38, 0x36, 0x65, 0x38, 0x59, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 
+0x56, 0x39, 0x35, 0x6e, 0x4e, 0x4b, 0x59, 0x32, 
+0x59, 0x74, 0x44, 0x75, 0x78, 0x79, 0x51, 0x36, 
+0x4b, 0x34, 0x75, 0x6e, 0x72, 0x6b, 0x4b, 0x51, 
+0x54, 0x6d, 0x68, 0x52, 0x70, 0x56, 0x63, 0x55, 
+0x69, 0x58, 0x64, 0x59, 0x4b, 0x78, 0x66, 0x4a, 
+0x53, 0x72, 0x51, 0x47, 0x32, 0x32, 0x74, 0x48, 
+0x6d, 0x4e, 0x6f, 0x6a, 0x61, 0x58, 0x63, 0x35, 
+0x67, 0x55, 0x79, 0x31, 0x5a, 0x59, 0x36, 0x63, 
+0x41, 0x42, 0x79, 0x43, 0x42, 0x4d, 0x5a, 0x5a, 
+0x73, 0x61, 0x73, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x32, 0x44, 0x37, 0x39, 0x78, 
+0x6d, 0x61, 0x41, 0x5a, 0x78, 0x54, 0x66, 0x32, 
+0x66, 0x4d, 0x52, 0x73, 0x54, 0x47, 0x67, 0x6b, 
+0x4e, 0x66, 0x4d, 0x72, 0x55, 0x45, 0x72, 0x6a, 
+0x35, 0x43, 0x71, 0x58, 0x4e, 0x59, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x37, 0x6e, 
+0x77, 0x51, 0x35, 0x39, 0x35, 0x41, 0x37, 0x6e, 
+0x58, 0x64, 0x79, 0x53, 0x46, 0x51, 0x32, 0x70, 
+0x48, 0x78, 0x37, 0x31, 0x78, 0x4a, 0x73, 0x56, 
+0x4c, 0x68, 0x4a, 0x41, 0x65, 0x6f, 0x6a, 0x36, 
+0x38, 0x4d, 0x53, 0x53, 0x44, 0x48, 0x68, 0x50, 
+0x4d, 0x78, 0x68, 0x42, 0x51, 0x44, 0x79, 0x6e, 
+0x59, 0x61, 0x35, 0x4b, 0x44, 0x58, 0x45, 0x66, 
+0x68, 0x57, 0x38, 0x6a, 0x5a, 0x64, 0x5a, 0x65, 
+0x41, 0x6b, 0x72, 0x61, 0x46, 0x4d, 0x79, 0x37, 
+0x62, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x37, 0x72, 0x4c, 0x4d, 0x52, 0x6e, 0x38, 
+0x56, 0x53, 0x6d, 0x73, 0x47, 0x56, 0x31, 0x51, 
+0x55, 0x66, 0x5a, 0x66, 0x35, 0x78, 0x72, 0x6f, 
+0x35, 0x67, 0x65, 0x6a, 0x45, 0x53, 0x54, 0x34, 
+0x66, 0x75, 0x58, 0x70, 0x6f, 0x6b, 0x4b, 0x53, 
+0x76, 0x71, 0x50, 0x50, 0x58, 0x38, 0x77, 0x6d, 
+0x4d, 0x61, 0x62, 0x65, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x4a, 0x33, 0x4a, 0x74, 
+0x53, 0x51, 0x69, 0x5a, 0x34, 0x36, 0x79, 0x58, 
+0x4e, 0x45, 0x58, 0x70, 0x75, 0x7a, 0x6a, 0x6d, 
+0x41, 0x37, 0x52, 0x33, 0x36, 0x36, 0x42, 0x42, 
+0x4b, 0x4d, 0x44, 0x37, 0x69, 0x64, 0x35, 0x50, 
+0x5a, 0x37, 0x63, 0x58, 0x33, 0x56, 0x35, 0x4b, 
+0x35, 0x44, 0x63, 0x50, 0x33, 0x4d, 0x39, 0x4c, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x31, 0x57, 0x46, 0x54, 0x47, 0x5a, 0x45, 
+0x70, 0x4c, 0x79, 0x47, 0x48, 0x71, 0x56, 0x6d, 
+0x62, 0x37, 0x61, 0x35, 0x73, 0x6b, 0x50, 0x44, 
+0x4e, 0x35, 0x6f, 0x44, 0x37, 0x6f, 0x63, 0x52, 
+0x37, 0x72, 0x36, 0x74, 0x32, 0x6f, 0x73, 0x69, 
+0x71, 0x44, 0x51, 0x66, 0x36, 0x58, 0x61, 0x38, 
+0x34, 0x6d, 0x6b, 0x68, 0x33, 0x6f, 0x64, 0x45, 
+0x31, 0x63, 0x62, 0x5a, 0x32, 0x6f, 0x63, 0x54, 
+0x46, 0x4d, 0x5a, 0x62, 0x48, 0x53, 0x72, 0x4c, 
+0x58, 0x79, 0x4a, 0x72, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x37, 0x6f, 0x53, 0x68, 
+0x53, 0x4d, 0x79, 0x5a, 0x71, 0x6f, 0x4b, 0x36, 
+0x39, 0x74, 0x57, 0x76, 0x55, 0x45, 0x77, 0x4c, 
+0x42, 0x47, 0x57, 0x48, 0x7a, 0x5a, 0x46, 0x76, 
+0x75, 0x56, 0x56, 0x35, 0x53, 0x45, 0x53, 0x61, 
+0x34, 0x72, 0x42, 0x65, 0x33, 0x54, 0x6d, 0x4e, 
+0x7a, 0x66, 0x4a, 0x58, 0x42, 0x4a, 0x42, 0x50, 
+0x35, 0x32, 0x38, 0x58, 0x4d, 0x4d, 0x4d, 0x69, 
+0x51, 0x78, 0x6f, 0x58, 0x37, 0x66, 0x53, 0x41, 
+0x7a, 0x68, 0x46, 0x32, 0x62, 0x59, 0x4c, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x4b, 
+0x71, 0x61, 0x72, 0x59, 0x51, 0x32, 0x41, 0x34, 
+0x6a, 0x69, 0x6d, 0x42, 0x65, 0x66, 0x4c, 0x35, 
+0x69, 0x31, 0x53, 0x52, 0x70, 0x62, 0x7a, 0x38, 
+0x78, 0x6e, 0x33, 0x79, 0x33, 0x50, 0x32, 0x55, 
+0x58, 0x31, 0x74, 0x61, 0x66, 0x43, 0x67, 0x66, 
+0x34, 0x38, 0x4c, 0x58, 0x54, 0x44, 0x72, 0x4b, 
+0x43, 0x63, 0x66, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x67, 0x53, 0x7a, 0x71, 0x34, 
+0x53, 0x74, 0x46, 0x72, 0x73, 0x32, 0x69, 0x38, 
+0x67, 0x54, 0x5a, 0x38, 0x34, 0x70, 0x77, 0x39, 
+0x78, 0x36, 0x38, 0x61, 0x50, 0x51, 0x33, 0x58, 
+0x46, 0x65, 0x35, 0x62, 0x33, 0x6f, 0x4b, 0x36, 
+0x36, 0x39, 0x61, 0x53, 0x64, 0x36, 0x38, 0x79, 
+0x66, 0x46, 0x6d, 0x78, 0x48, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x37, 0x55, 0x64, 
+0x68, 0x56, 0x39, 0x35, 0x47, 0x53, 0x61, 0x36, 
+0x43, 0x59, 0x32, 0x58, 0x6a, 0x56, 0x59, 0x66, 
+0x72, 0x71, 0x72, 0x77, 0x77, 0x79, 0x43, 0x53, 
+0x63, 0x6d, 0x65, 0x6b, 0x73, 0x75, 0x36, 0x54, 
+0x43, 0x71, 0x63, 0x70, 0x52, 0x53, 0x65, 0x65, 
+0x4d, 0x62, 0x45, 0x6d, 0x44, 0x79, 0x64, 0x53, 
+0x4d, 0x42, 0x34, 0x45, 0x32, 0x43, 0x43, 0x48, 
+0x46, 0x5a, 0x34, 0x67, 0x4c, 0x6f, 0x58, 0x58, 
+0x42, 0x37, 0x7a, 0x31, 0x69, 0x57, 0x73, 0x47, 
+0x77, 0x73, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x32, 0x6d, 0x73, 0x76, 0x7a, 0x64, 
+0x56, 0x74, 0x38, 0x36, 0x59, 0x56, 0x58, 0x71, 
+0x6b, 0x57, 0x51, 0x42, 0x4a, 0x47, 0x31, 0x33, 
+0x36, 0x75, 0x31, 0x31, 0x52, 0x45, 0x69, 0x38, 
+0x63, 0x58, 0x70, 0x6e, 0x31, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x72, 0x79, 0x4d, 
+0x69, 0x79, 0x37, 0x54, 0x53, 0x56, 0x34, 0x4c, 
+0x66, 0x6e, 0x4a, 0x57, 0x65, 0x58, 0x64, 0x76, 
+0x54, 0x39, 0x73, 0x5a, 0x67, 0x69, 0x4c, 0x6a, 
+0x36, 0x65, 0x62, 0x4e, 0x67, 0x32, 0x61, 0x63, 
+0x36, 0x65, 0x4c, 0x64, 0x53, 0x41, 0x45, 0x31, 
+0x4e, 0x36, 0x36, 0x75, 0x31, 0x53, 0x48, 0x77, 
+0x41, 0x53, 0x61, 0x6d, 0x37, 0x6e, 0x6a, 0x56, 
+0x42, 0x4d, 0x4c, 0x59, 0x75, 0x7a, 0x72, 0x38, 
+0x6e, 0x74, 0x79, 0x53, 0x4e, 0x6f, 0x55, 0x54, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x36, 0x59, 0x6e, 0x78, 0x51, 0x70, 0x77, 0x4c, 
+0x76, 0x32, 0x50, 0x57, 0x56, 0x52, 0x77, 0x38, 
+0x63, 0x66, 0x35, 0x4a, 0x56, 0x6d, 0x31, 0x48, 
+0x6d, 0x4c, 0x50, 0x33, 0x55, 0x72, 0x51, 0x79, 
+0x79, 0x55, 0x4d, 0x75, 0x66, 0x44, 0x4c, 0x7a, 
+0x75, 0x59, 0x52, 0x67, 0x31, 0x76, 0x62, 0x75, 
+0x74, 0x39, 0x68, 0x65, 0x32, 0x37, 0x58, 0x41, 
+0x7a, 0x6d, 0x4c, 0x70, 0x37, 0x6d, 0x34, 0x57, 
+0x78, 0x54, 0x7a, 0x37, 0x76, 0x73, 0x72, 0x69, 
+0x45, 0x77, 0x51, 0x63, 0x58, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x39, 0x32, 0x67, 
+0x36, 0x69, 0x63, 0x79, 0x4c, 0x33, 0x48, 0x32, 
+0x58, 0x43, 0x71, 0x4c, 0x69, 0x75, 0x6b, 0x71, 
+0x71, 0x75, 0x58, 0x31, 0x35, 0x66, 0x77, 0x42, 
+0x52, 0x35, 0x6b, 0x46, 0x45, 0x37, 0x34, 0x34, 
+0x45, 0x6e, 0x35, 0x63, 0x64, 0x33, 0x58, 0x36, 
+0x31, 0x63, 0x70, 0x41, 0x4e, 0x72, 0x6a, 0x71, 
+0x59, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x32, 0x58, 0x43, 0x78, 0x65, 0x39, 0x45, 
+0x70, 0x65, 0x47, 0x56, 0x4d, 0x6b, 0x66, 0x5a, 
+0x71, 0x46, 0x67, 0x74, 0x41, 0x4b, 0x6d, 0x55, 
+0x32, 0x47, 0x4e, 0x42, 0x70, 0x77, 0x6e, 0x6d, 
+0x75, 0x6b, 0x44, 0x73, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x36, 0x59, 0x64, 0x72, 
+0x57, 0x33, 0x56, 0x44, 0x79, 0x45, 0x39, 0x36, 
+0x6b, 0x42, 0x46, 0x76, 0x4b, 0x67, 0x68, 0x72, 
+0x5a, 0x36, 0x66, 0x6b, 0x77, 0x56, 0x6e, 0x67, 
+0x47, 0x67, 0x4a, 0x79, 0x62, 0x46, 0x6e, 0x72, 
+0x46, 0x48, 0x58, 0x66, 0x65, 0x78, 0x53, 0x6f, 
+0x72, 0x63, 0x51, 0x50, 0x78, 0x7a, 0x62, 0x48, 
+0x4c, 0x71, 0x4e, 0x57, 0x54, 0x53, 0x4d, 0x5a, 
+0x48, 0x6b, 0x72, 0x64, 0x6d, 0x65, 0x51, 0x32, 
+0x5a, 0x73, 0x4c, 0x43, 0x6e, 0x46, 0x68, 0x65, 
+0x33, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x50, 0x73, 0x66, 0x6b, 0x41, 0x78, 0x75, 
+0x68, 0x44, 0x51, 0x4b, 0x51, 0x43, 0x77, 0x76, 
+0x75, 0x77, 0x66, 0x69, 0x56, 0x6f, 0x31, 0x76, 
+0x64, 0x63, 0x59, 0x63, 0x34, 0x66, 0x4c, 0x4c, 
+0x72, 0x37, 0x6f, 0x5a, 0x39, 0x38, 0x58, 0x72, 
+0x4d, 0x79, 0x70, 0x37, 0x53, 0x41, 0x73, 0x4c, 
+0x41, 0x79, 0x51, 0x6f, 0x72, 0x46, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 0x6b, 
+0x32, 0x48, 0x65, 0x61, 0x7a, 0x5a, 0x31, 0x61, 
+0x70, 0x77, 0x73, 0x46, 0x33, 0x56, 0x51, 0x48, 
+0x48, 0x43, 0x62, 0x6f, 0x6f, 0x72, 0x65, 0x4a, 
+0x32, 0x61, 0x6e, 0x6a, 0x75, 0x6d, 0x54, 0x54, 
+0x55, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x37, 0x32, 0x34, 0x46, 0x77, 0x33, 0x54, 
+0x46, 0x6f, 0x53, 0x6f, 0x58, 0x73, 0x5a, 0x4b, 
+0x37, 0x37, 0x46, 0x43, 0x38, 0x4e, 0x66, 0x72, 
+0x67, 0x4e, 0x32, 0x73, 0x63, 0x56, 0x43, 0x38, 
+0x70, 0x71, 0x37, 0x53, 0x6e, 0x74, 0x6f, 0x4e, 
+0x67, 0x43, 0x59, 0x33, 0x6f, 0x6f, 0x73, 0x6d, 
+0x45, 0x5a, 0x48, 0x4a, 0x4c, 0x63, 0x72, 0x5a, 
+0x56, 0x4b, 0x69, 0x46, 0x61, 0x67, 0x46, 0x6d, 
+0x35, 0x54, 0x4c, 0x63, 0x62, 0x66, 0x75, 0x68, 
+0x4b, 0x6d, 0x38, 0x65, 0x77, 0x4d, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x37, 0x56, 
+0x72, 0x62, 0x63, 0x53, 0x71, 0x43, 0x4a, 0x6e, 
+0x64, 0x63, 0x70, 0x31, 0x38, 0x37, 0x42, 0x54, 
+0x36, 0x38, 0x54, 0x35, 0x65, 0x4c, 0x58, 0x46, 
+0x33, 0x54, 0x51, 0x61, 0x48, 0x37, 0x76, 0x4e, 
+0x35, 0x37, 0x6e, 0x41, 0x68, 0x4e, 0x68, 0x62, 
+0x43, 0x79, 0x55, 0x6a, 0x74, 0x76, 0x75, 0x58, 
+0x36, 0x72, 0x74, 0x44, 0x4a, 0x59, 0x4e, 0x4c, 
+0x6d, 0x58, 0x68, 0x50, 0x54, 0x53, 0x72, 0x45, 
+0x35, 0x64, 0x6b, 0x57, 0x71, 0x69, 0x66, 0x53, 
+0x73, 0x52, 0x47, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x38, 0x53, 0x48, 0x78, 0x7a, 
+0x41, 0x52, 0x63, 0x55, 0x4b, 0x4d, 0x36, 0x4e, 
+0x64, 0x4c, 0x79, 0x4d, 0x34, 0x4a, 0x44, 0x53, 
+0x4d, 0x6f, 0x53, 0x6b, 0x41, 0x39, 0x39, 0x53, 
+0x67, 0x5a, 0x33, 0x7a, 0x50, 0x38, 0x35, 0x4a, 
+0x41, 0x45, 0x61, 0x69, 0x69, 0x70, 0x78, 0x6e, 
+0x55, 0x58, 0x75, 0x4d, 0x42, 0x74, 0x56, 0x37, 
+0x64, 0x74, 0x78, 0x36, 0x63, 0x4e, 0x31, 0x77, 
+0x50, 0x35, 0x64, 0x66, 0x34, 0x62, 0x51, 0x38, 
+0x47, 0x36, 0x4d, 0x73, 0x4d, 0x76, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x0a, 0x5d, 0x0a, 
+};};